@@ -42,6 +42,7 @@ public class FastAssets : ModuleRules
 				"ToolMenus",
 				"Slate",
 				"SlateCore",
+				"SlateRHIRenderer",
 				"EditorStyle",
 				"AssetTools",
 				"ContentBrowser",
@@ -56,11 +57,62 @@ public class FastAssets : ModuleRules
 				"DeveloperSettings",
 				"ApplicationCore",
 				"ImageWrapper",
-				"RenderCore"
+				"ImageCore",
+				"RenderCore",
+				"RHI",
+				"Json"
 			}
 			);
 		
 		
+		// libjpeg-turbo lets JPEG thumbnails decode at 1/2, 1/4 or 1/8 scale; other platforms use ImageWrapper
+		bool bWithLibJpegTurbo = Target.Platform == UnrealTargetPlatform.Win64 ||
+			Target.Platform == UnrealTargetPlatform.Mac ||
+			Target.Platform == UnrealTargetPlatform.Linux;
+
+		if (bWithLibJpegTurbo)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "libjpeg-turbo");
+		}
+		PrivateDefinitions.Add("FASTASSETS_WITH_LIBJPEGTURBO=" + (bWithLibJpegTurbo ? "1" : "0"));
+
+		// Ogg Vorbis waveforms use the engine's Vorbis libraries where they ship
+		bool bWithVorbis = Target.Platform == UnrealTargetPlatform.Win64 ||
+			Target.Platform == UnrealTargetPlatform.Mac ||
+			Target.Platform == UnrealTargetPlatform.Linux;
+
+		if (bWithVorbis)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "UEOgg", "Vorbis", "VorbisFile");
+
+			// LoadVorbisLibraries, which loads the delay-loaded DLLs on Windows
+			PrivateDependencyModuleNames.Add("VorbisAudioDecoder");
+		}
+		PrivateDefinitions.Add("FASTASSETS_WITH_VORBIS=" + (bWithVorbis ? "1" : "0"));
+
+		// libtiff lets TIFF thumbnails come from a reduced subfile or a subset of strips
+		bool bWithLibTiff = Target.Platform == UnrealTargetPlatform.Win64 ||
+			Target.Platform == UnrealTargetPlatform.Mac ||
+			Target.Platform == UnrealTargetPlatform.Linux;
+
+		if (bWithLibTiff)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "LibTiff");
+		}
+		PrivateDefinitions.Add("FASTASSETS_WITH_LIBTIFF=" + (bWithLibTiff ? "1" : "0"));
+
+		// OpenEXR lets large EXRs be previewed from a mip level or a subset of scanlines; it reports errors by throwing
+		bool bWithOpenExr = Target.Platform == UnrealTargetPlatform.Win64 ||
+			Target.Platform == UnrealTargetPlatform.Mac ||
+			Target.Platform == UnrealTargetPlatform.Linux;
+
+		if (bWithOpenExr)
+		{
+			AddEngineThirdPartyPrivateStaticDependencies(Target, "Imath", "UEOpenExr");
+			bEnableExceptions = true;
+		}
+		PrivateDefinitions.Add("FASTASSETS_WITH_OPENEXR=" + (bWithOpenExr ? "1" : "0"));
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -5,6 +5,10 @@
 #include "FastAssetsCommands.h"
 #include "SFastAssetsWindow.h"
 #include "FastAssetsDropHandler.h"
+#include "FastAssetsThumbnail.h"
+#include "FastAssetsUpdateApplier.h"
+#include "FastAssetsSettings.h"
+#include "FastAssetsWarmUp.h"
 #include "Misc/MessageDialog.h"
 #include "ToolMenus.h"
 #include "Widgets/Docking/SDockTab.h"
@@ -18,9 +22,11 @@ const FName FFastAssetsModule::FastAssetsTabName("FastAssetsTab");
 
 void FFastAssetsModule::StartupModule()
 {
-	// Initialize style
+	// Only what the menus and the tab spawner need; everything else waits until the window is opened
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Initialize style; its one icon is loaded when first drawn, so no texture reload is needed
 	FFastAssetsStyle::Initialize();
-	FFastAssetsStyle::ReloadTextures();
 
 	// Register commands
 	FFastAssetsCommands::Register();
@@ -43,9 +49,30 @@ void FFastAssetsModule::StartupModule()
 		.SetGroup(WorkspaceMenu::GetMenuStructure().GetToolsCategory())
 		.SetIcon(FSlateIcon(FFastAssetsStyle::GetStyleSetName(), "FastAssets.PluginAction"));
 
-	// Initialize drop handler
+	// Scan recent folders once the editor is up; not in the thumbnail helper processes
+	if (UFastAssetsSettings::Get()->bWarmUpRecentPaths && !IsRunningCommandlet())
+	{
+		WarmUp = MakeShareable(new FFastAssetsWarmUp());
+		WarmUp->Start();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FastAssets: Module startup took %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FFastAssetsModule::InitializeOnFirstUse()
+{
+	if (DropHandler.IsValid())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Loads the level editor and content browser hooks; a drag can only start in a window, so it is ready before any drop
 	DropHandler = MakeShareable(new FFastAssetsDropHandler());
 	DropHandler->Initialize();
+
+	UE_LOG(LogTemp, Log, TEXT("FastAssets: First use initialization took %.2f ms"), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 }
 
 void FFastAssetsModule::ShutdownModule()
@@ -57,6 +84,15 @@ void FFastAssetsModule::ShutdownModule()
 		DropHandler.Reset();
 	}
 
+	// Drops the warmed up catalogs, cancelling a scan still running
+	WarmUp.Reset();
+
+	// Stop thumbnail uploads and release cached textures
+	FFastAssetsThumbnail::Shutdown();
+
+	// After the thumbnails, which unregister their upload queue from it
+	FFastAssetsUpdateApplier::Shutdown();
+
 	// Unregister tab spawner
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FastAssetsTabName);
 
@@ -81,7 +117,7 @@ bool FFastAssetsModule::IsAvailable()
 
 FFastAssetsDropHandler& FFastAssetsModule::GetDropHandler()
 {
-	check(DropHandler.IsValid());
+	InitializeOnFirstUse();
 	return *DropHandler;
 }
 
@@ -90,8 +126,24 @@ void FFastAssetsModule::OpenFastAssetsWindow()
 	FGlobalTabmanager::Get()->TryInvokeTab(FastAssetsTabName);
 }
 
+void FFastAssetsModule::OpenNewFastAssetsTab(const FString& Path)
+{
+	// The registered tab is a single instance, so extra tabs are docked next to it unmanaged
+	TSharedRef<SDockTab> NewTab = SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab)
+		.Label(LOCTEXT("FastAssetsTabTitle", "Fast Assets"))
+		[
+			SNew(SFastAssetsWindow)
+			.InitialPath(Path)
+		];
+
+	FGlobalTabmanager::Get()->InsertNewDocumentTab(FastAssetsTabName, FTabManager::ESearchPreference::PreferLiveTab, NewTab);
+}
+
 TSharedRef<SDockTab> FFastAssetsModule::OnSpawnFastAssetsTab(const FSpawnTabArgs& SpawnTabArgs)
 {
+	InitializeOnFirstUse();
+
 	return SNew(SDockTab)
 		.TabRole(ETabRole::NomadTab)
 		[
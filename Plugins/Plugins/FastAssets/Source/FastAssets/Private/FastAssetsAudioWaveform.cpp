@@ -0,0 +1,667 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsAudioWaveform.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+#if FASTASSETS_WITH_VORBIS
+#include "VorbisAudioInfo.h"
+THIRD_PARTY_INCLUDES_START
+#include "vorbis/vorbisfile.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+namespace FastAssetsAudioWaveform
+{
+	typedef TArray<float, TAlignedHeapAllocator<16>> FAlignedFloatArray;
+
+	/** Bytes of PCM read from disk per step */
+	static constexpr int64 ChunkBytes = 256 * 1024;
+
+	/** Frames requested from the Vorbis decoder per step */
+	static constexpr int32 VorbisChunkFrames = 4096;
+
+	/** Sample encodings found in WAV and AIFF data */
+	enum class ESampleFormat : uint8
+	{
+		UInt8,
+		Int8,
+		Int16,
+		Int24,
+		Int32,
+		Float32
+	};
+
+	/** Interleaved PCM layout and where it sits in the file */
+	struct FPcmLayout
+	{
+		ESampleFormat Format = ESampleFormat::Int16;
+		int32 NumChannels = 0;
+		int32 BytesPerSample = 0;
+		bool bBigEndian = false;
+		int64 DataOffset = 0;
+		int64 DataSize = 0;
+	};
+
+	/** Min, max and sum of squares of a run of samples, four at a time */
+	static void ReduceSamples(const float* Samples, int64 Num, float& InOutMin, float& InOutMax, double& InOutSumSquares)
+	{
+		VectorRegister4Float Min = VectorSetFloat1(InOutMin);
+		VectorRegister4Float Max = VectorSetFloat1(InOutMax);
+		VectorRegister4Float SumSquares = VectorZeroFloat();
+
+		int64 Index = 0;
+		for (; Index + 4 <= Num; Index += 4)
+		{
+			const VectorRegister4Float Value = VectorLoad(Samples + Index);
+			Min = VectorMin(Min, Value);
+			Max = VectorMax(Max, Value);
+			SumSquares = VectorMultiplyAdd(Value, Value, SumSquares);
+		}
+
+		alignas(16) float MinLanes[4];
+		alignas(16) float MaxLanes[4];
+		alignas(16) float SumLanes[4];
+		VectorStoreAligned(Min, MinLanes);
+		VectorStoreAligned(Max, MaxLanes);
+		VectorStoreAligned(SumSquares, SumLanes);
+
+		float RunMin = FMath::Min(FMath::Min(MinLanes[0], MinLanes[1]), FMath::Min(MinLanes[2], MinLanes[3]));
+		float RunMax = FMath::Max(FMath::Max(MaxLanes[0], MaxLanes[1]), FMath::Max(MaxLanes[2], MaxLanes[3]));
+		double RunSum = (double)SumLanes[0] + SumLanes[1] + SumLanes[2] + SumLanes[3];
+
+		for (; Index < Num; Index++)
+		{
+			const float Value = Samples[Index];
+			RunMin = FMath::Min(RunMin, Value);
+			RunMax = FMath::Max(RunMax, Value);
+			RunSum += Value * Value;
+		}
+
+		InOutMin = RunMin;
+		InOutMax = RunMax;
+		InOutSumSquares += RunSum;
+	}
+
+	/** Folds a stream of interleaved frames into a fixed number of equally sized buckets */
+	class FPeakAccumulator
+	{
+	public:
+		FPeakAccumulator(int64 InTotalFrames, int32 InNumChannels, FFastAssetsWaveformPeaks& InPeaks)
+			: TotalFrames(InTotalFrames)
+			, NumChannels(InNumChannels)
+			, NumBuckets((int32)FMath::Clamp<int64>(InTotalFrames, 1, NumPeakBuckets))
+			, Peaks(InPeaks)
+		{
+			Peaks.Buckets.Reset(NumBuckets * 4);
+			ResetBucket();
+		}
+
+		void AddFrames(const float* Samples, int64 NumFrames)
+		{
+			while (NumFrames > 0 && Peaks.Num() < NumBuckets)
+			{
+				const int64 Take = FMath::Min(NumFrames, BucketEnd - FramePosition);
+				if (Take > 0)
+				{
+					ReduceSamples(Samples, Take * NumChannels, Min, Max, SumSquares);
+					NumSamples += Take * NumChannels;
+					Samples += Take * NumChannels;
+					NumFrames -= Take;
+					FramePosition += Take;
+				}
+
+				if (FramePosition >= BucketEnd)
+				{
+					EmitBucket();
+				}
+			}
+		}
+
+		/** Close the last bucket; anything the file did not deliver stays silent */
+		void Finish()
+		{
+			while (Peaks.Num() < NumBuckets)
+			{
+				EmitBucket();
+			}
+		}
+
+	private:
+		void ResetBucket()
+		{
+			BucketEnd = (Peaks.Num() + 1) * TotalFrames / NumBuckets;
+			Min = UE_MAX_FLT;
+			Max = -UE_MAX_FLT;
+			SumSquares = 0.0;
+			NumSamples = 0;
+		}
+
+		void EmitBucket()
+		{
+			const float BucketMin = NumSamples > 0 ? FMath::Clamp(Min, -1.0f, 1.0f) : 0.0f;
+			const float BucketMax = NumSamples > 0 ? FMath::Clamp(Max, -1.0f, 1.0f) : 0.0f;
+			const float BucketRms = NumSamples > 0 ? FMath::Min((float)FMath::Sqrt(SumSquares / NumSamples), 1.0f) : 0.0f;
+
+			Peaks.Buckets.Add((uint8)FMath::RoundToInt((BucketMin * 0.5f + 0.5f) * 255.0f));
+			Peaks.Buckets.Add((uint8)FMath::RoundToInt((BucketMax * 0.5f + 0.5f) * 255.0f));
+			Peaks.Buckets.Add((uint8)FMath::RoundToInt(BucketRms * 255.0f));
+			Peaks.Buckets.Add(255);
+
+			ResetBucket();
+		}
+
+		int64 TotalFrames;
+		int32 NumChannels;
+		int32 NumBuckets;
+		FFastAssetsWaveformPeaks& Peaks;
+
+		int64 FramePosition = 0;
+		int64 BucketEnd = 0;
+		float Min = 0.0f;
+		float Max = 0.0f;
+		double SumSquares = 0.0;
+		int64 NumSamples = 0;
+	};
+
+	static uint32 ReadU32LE(const uint8* Data)
+	{
+		return Data[0] | ((uint32)Data[1] << 8) | ((uint32)Data[2] << 16) | ((uint32)Data[3] << 24);
+	}
+
+	static uint16 ReadU16LE(const uint8* Data)
+	{
+		return (uint16)(Data[0] | (Data[1] << 8));
+	}
+
+	static uint32 ReadU32BE(const uint8* Data)
+	{
+		return ((uint32)Data[0] << 24) | ((uint32)Data[1] << 16) | ((uint32)Data[2] << 8) | Data[3];
+	}
+
+	static uint16 ReadU16BE(const uint8* Data)
+	{
+		return (uint16)((Data[0] << 8) | Data[1]);
+	}
+
+	/** Convert raw interleaved samples to floats in [-1, 1] */
+	static void ConvertSamples(const uint8* Src, int64 NumSamples, const FPcmLayout& Layout, float* Dst)
+	{
+		switch (Layout.Format)
+		{
+		case ESampleFormat::UInt8:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				Dst[Index] = ((int32)Src[Index] - 128) * (1.0f / 128.0f);
+			}
+			break;
+
+		case ESampleFormat::Int8:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				Dst[Index] = (int8)Src[Index] * (1.0f / 128.0f);
+			}
+			break;
+
+		case ESampleFormat::Int16:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				const uint8* Sample = Src + Index * 2;
+				Dst[Index] = (int16)(Layout.bBigEndian ? ReadU16BE(Sample) : ReadU16LE(Sample)) * (1.0f / 32768.0f);
+			}
+			break;
+
+		case ESampleFormat::Int24:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				const uint8* Sample = Src + Index * 3;
+				const uint32 Bits = Layout.bBigEndian
+					? ((uint32)Sample[0] << 24) | ((uint32)Sample[1] << 16) | ((uint32)Sample[2] << 8)
+					: ((uint32)Sample[2] << 24) | ((uint32)Sample[1] << 16) | ((uint32)Sample[0] << 8);
+				Dst[Index] = (int32)Bits * (1.0f / 2147483648.0f);
+			}
+			break;
+
+		case ESampleFormat::Int32:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				const uint8* Sample = Src + Index * 4;
+				Dst[Index] = (int32)(Layout.bBigEndian ? ReadU32BE(Sample) : ReadU32LE(Sample)) * (1.0f / 2147483648.0f);
+			}
+			break;
+
+		case ESampleFormat::Float32:
+			for (int64 Index = 0; Index < NumSamples; Index++)
+			{
+				const uint8* Sample = Src + Index * 4;
+				const uint32 Bits = Layout.bBigEndian ? ReadU32BE(Sample) : ReadU32LE(Sample);
+				float Value;
+				FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+				Dst[Index] = FMath::IsFinite(Value) ? Value : 0.0f;
+			}
+			break;
+		}
+	}
+
+	/** Integer sample format for a container size in bytes */
+	static bool IntegerFormatForSize(int32 BytesPerSample, bool bUnsigned8, ESampleFormat& OutFormat)
+	{
+		switch (BytesPerSample)
+		{
+		case 1: OutFormat = bUnsigned8 ? ESampleFormat::UInt8 : ESampleFormat::Int8; return true;
+		case 2: OutFormat = ESampleFormat::Int16; return true;
+		case 3: OutFormat = ESampleFormat::Int24; return true;
+		case 4: OutFormat = ESampleFormat::Int32; return true;
+		default: return false;
+		}
+	}
+
+	/** Walk the RIFF chunks of a WAV file up to the sample data */
+	static bool ParseWav(IFileHandle& File, FPcmLayout& OutLayout)
+	{
+		const int64 FileSize = File.Size();
+
+		uint8 Header[12];
+		if (!File.Read(Header, sizeof(Header)) || FMemory::Memcmp(Header, "RIFF", 4) != 0 || FMemory::Memcmp(Header + 8, "WAVE", 4) != 0)
+		{
+			return false;
+		}
+
+		bool bHaveFormat = false;
+		int64 ChunkStart = 12;
+		while (ChunkStart + 8 <= FileSize)
+		{
+			uint8 ChunkHeader[8];
+			if (!File.Seek(ChunkStart) || !File.Read(ChunkHeader, sizeof(ChunkHeader)))
+			{
+				return false;
+			}
+
+			const int64 ChunkSize = ReadU32LE(ChunkHeader + 4);
+			const int64 DataStart = ChunkStart + 8;
+
+			if (FMemory::Memcmp(ChunkHeader, "fmt ", 4) == 0 && ChunkSize >= 16)
+			{
+				uint8 Format[40] = {};
+				if (!File.Read(Format, FMath::Min<int64>(ChunkSize, sizeof(Format))))
+				{
+					return false;
+				}
+
+				uint16 FormatTag = ReadU16LE(Format);
+				const int32 NumChannels = ReadU16LE(Format + 2);
+				const int32 BlockAlign = ReadU16LE(Format + 12);
+
+				// WAVE_FORMAT_EXTENSIBLE keeps the real format in the first two bytes of the sub-format GUID
+				if (FormatTag == 0xFFFE && ChunkSize >= 40)
+				{
+					FormatTag = ReadU16LE(Format + 24);
+				}
+
+				if (NumChannels <= 0 || BlockAlign <= 0 || BlockAlign % NumChannels != 0)
+				{
+					return false;
+				}
+
+				OutLayout.NumChannels = NumChannels;
+				OutLayout.BytesPerSample = BlockAlign / NumChannels;
+				OutLayout.bBigEndian = false;
+
+				if (FormatTag == 3 && OutLayout.BytesPerSample == 4)
+				{
+					OutLayout.Format = ESampleFormat::Float32;
+				}
+				else if (FormatTag != 1 || !IntegerFormatForSize(OutLayout.BytesPerSample, true, OutLayout.Format))
+				{
+					// Compressed or 64-bit data, not worth a decoder for a thumbnail
+					return false;
+				}
+				bHaveFormat = true;
+			}
+			else if (FMemory::Memcmp(ChunkHeader, "data", 4) == 0)
+			{
+				if (!bHaveFormat)
+				{
+					return false;
+				}
+
+				// Streaming writers leave the size at 0 or 0xFFFFFFFF; take everything up to the end
+				OutLayout.DataOffset = DataStart;
+				OutLayout.DataSize = (ChunkSize == 0 || DataStart + ChunkSize > FileSize) ? FileSize - DataStart : ChunkSize;
+				return true;
+			}
+
+			ChunkStart = DataStart + ChunkSize + (ChunkSize & 1);
+		}
+
+		return false;
+	}
+
+	/** Walk the IFF chunks of an AIFF or AIFF-C file up to the sample data */
+	static bool ParseAiff(IFileHandle& File, FPcmLayout& OutLayout)
+	{
+		const int64 FileSize = File.Size();
+
+		uint8 Header[12];
+		if (!File.Read(Header, sizeof(Header)) || FMemory::Memcmp(Header, "FORM", 4) != 0)
+		{
+			return false;
+		}
+
+		const bool bAifc = FMemory::Memcmp(Header + 8, "AIFC", 4) == 0;
+		if (!bAifc && FMemory::Memcmp(Header + 8, "AIFF", 4) != 0)
+		{
+			return false;
+		}
+
+		bool bHaveFormat = false;
+		int64 NumFrames = 0;
+		int64 ChunkStart = 12;
+		while (ChunkStart + 8 <= FileSize)
+		{
+			uint8 ChunkHeader[8];
+			if (!File.Seek(ChunkStart) || !File.Read(ChunkHeader, sizeof(ChunkHeader)))
+			{
+				return false;
+			}
+
+			const int64 ChunkSize = ReadU32BE(ChunkHeader + 4);
+			const int64 DataStart = ChunkStart + 8;
+
+			if (FMemory::Memcmp(ChunkHeader, "COMM", 4) == 0 && ChunkSize >= 18)
+			{
+				uint8 Common[22] = {};
+				if (!File.Read(Common, FMath::Min<int64>(ChunkSize, sizeof(Common))))
+				{
+					return false;
+				}
+
+				OutLayout.NumChannels = (int16)ReadU16BE(Common);
+				NumFrames = ReadU32BE(Common + 2);
+				const int32 BitsPerSample = (int16)ReadU16BE(Common + 6);
+				OutLayout.BytesPerSample = (BitsPerSample + 7) / 8;
+				OutLayout.bBigEndian = true;
+
+				if (OutLayout.NumChannels <= 0 || !IntegerFormatForSize(OutLayout.BytesPerSample, false, OutLayout.Format))
+				{
+					return false;
+				}
+
+				if (bAifc && ChunkSize >= 22)
+				{
+					const uint8* Compression = Common + 18;
+					if (FMemory::Memcmp(Compression, "sowt", 4) == 0)
+					{
+						OutLayout.bBigEndian = false;
+					}
+					else if (FMemory::Memcmp(Compression, "fl32", 4) == 0 || FMemory::Memcmp(Compression, "FL32", 4) == 0)
+					{
+						OutLayout.Format = ESampleFormat::Float32;
+						OutLayout.BytesPerSample = 4;
+					}
+					else if (FMemory::Memcmp(Compression, "NONE", 4) != 0)
+					{
+						return false;
+					}
+				}
+				bHaveFormat = true;
+			}
+			else if (FMemory::Memcmp(ChunkHeader, "SSND", 4) == 0 && ChunkSize >= 8)
+			{
+				if (!bHaveFormat)
+				{
+					return false;
+				}
+
+				uint8 Sound[8];
+				if (!File.Read(Sound, sizeof(Sound)))
+				{
+					return false;
+				}
+
+				OutLayout.DataOffset = DataStart + 8 + ReadU32BE(Sound);
+				const int64 DeclaredSize = NumFrames * OutLayout.NumChannels * OutLayout.BytesPerSample;
+				OutLayout.DataSize = FMath::Max<int64>(FMath::Min(DeclaredSize, FileSize - OutLayout.DataOffset), 0);
+				return true;
+			}
+
+			ChunkStart = DataStart + ChunkSize + (ChunkSize & 1);
+		}
+
+		return false;
+	}
+
+	/** Stream PCM data through the accumulator one chunk at a time */
+	static bool ReducePcm(IFileHandle& File, const FPcmLayout& Layout, const std::atomic<bool>& CancelFlag, FFastAssetsWaveformPeaks& OutPeaks)
+	{
+		const int64 FrameBytes = (int64)Layout.NumChannels * Layout.BytesPerSample;
+		const int64 TotalFrames = Layout.DataSize / FrameBytes;
+		if (TotalFrames <= 0 || !File.Seek(Layout.DataOffset))
+		{
+			return false;
+		}
+
+		const int64 FramesPerChunk = FMath::Max<int64>(ChunkBytes / FrameBytes, 1);
+
+		TArray<uint8> Raw;
+		Raw.SetNumUninitialized(FramesPerChunk * FrameBytes);
+
+		FAlignedFloatArray Samples;
+		Samples.SetNumUninitialized(FramesPerChunk * Layout.NumChannels);
+
+		FPeakAccumulator Accumulator(TotalFrames, Layout.NumChannels, OutPeaks);
+		for (int64 Frame = 0; Frame < TotalFrames; Frame += FramesPerChunk)
+		{
+			if (CancelFlag)
+			{
+				return false;
+			}
+
+			const int64 NumFrames = FMath::Min(FramesPerChunk, TotalFrames - Frame);
+			if (!File.Read(Raw.GetData(), NumFrames * FrameBytes))
+			{
+				// Truncated file, the rest of the waveform stays silent
+				break;
+			}
+
+			ConvertSamples(Raw.GetData(), NumFrames * Layout.NumChannels, Layout, Samples.GetData());
+			Accumulator.AddFrames(Samples.GetData(), NumFrames);
+		}
+
+		Accumulator.Finish();
+		return true;
+	}
+
+#if FASTASSETS_WITH_VORBIS
+	static size_t OggRead(void* Buffer, size_t Size, size_t Count, void* DataSource)
+	{
+		IFileHandle* File = (IFileHandle*)DataSource;
+		const int64 Remaining = File->Size() - File->Tell();
+		const int64 Bytes = FMath::Min<int64>(Size * Count, Remaining);
+		if (Size == 0 || Bytes <= 0 || !File->Read((uint8*)Buffer, Bytes))
+		{
+			return 0;
+		}
+		return (size_t)(Bytes / Size);
+	}
+
+	static int OggSeek(void* DataSource, ogg_int64_t Offset, int Origin)
+	{
+		IFileHandle* File = (IFileHandle*)DataSource;
+		switch (Origin)
+		{
+		case SEEK_SET: return File->Seek(Offset) ? 0 : -1;
+		case SEEK_CUR: return File->Seek(File->Tell() + Offset) ? 0 : -1;
+		case SEEK_END: return File->SeekFromEnd(Offset) ? 0 : -1;
+		default: return -1;
+		}
+	}
+
+	static long OggTell(void* DataSource)
+	{
+		return (long)((IFileHandle*)DataSource)->Tell();
+	}
+
+	/** Decode Ogg Vorbis a packet at a time through the accumulator */
+	static bool ReduceOgg(IFileHandle& File, const std::atomic<bool>& CancelFlag, FFastAssetsWaveformPeaks& OutPeaks)
+	{
+		// The libraries are delay-loaded on Windows; load them once before the first ov_ call
+		static const bool bVorbisLoaded = LoadVorbisLibraries();
+		if (!bVorbisLoaded)
+		{
+			return false;
+		}
+
+		ov_callbacks Callbacks = { OggRead, OggSeek, nullptr, OggTell };
+
+		OggVorbis_File Vorbis;
+		if (ov_open_callbacks(&File, &Vorbis, nullptr, 0, Callbacks) < 0)
+		{
+			return false;
+		}
+		ON_SCOPE_EXIT
+		{
+			ov_clear(&Vorbis);
+		};
+
+		const vorbis_info* Info = ov_info(&Vorbis, -1);
+		const int64 TotalFrames = ov_pcm_total(&Vorbis, -1);
+		if (!Info || Info->channels <= 0 || TotalFrames <= 0)
+		{
+			return false;
+		}
+
+		const int32 NumChannels = Info->channels;
+		FAlignedFloatArray Interleaved;
+		Interleaved.SetNumUninitialized(VorbisChunkFrames * NumChannels);
+
+		FPeakAccumulator Accumulator(TotalFrames, NumChannels, OutPeaks);
+		int Section = 0;
+		while (true)
+		{
+			if (CancelFlag)
+			{
+				return false;
+			}
+
+			float** Channels = nullptr;
+			const long NumFrames = ov_read_float(&Vorbis, &Channels, VorbisChunkFrames, &Section);
+			if (NumFrames == OV_HOLE)
+			{
+				continue;
+			}
+
+			// Chained streams may change the channel layout; the first one is enough for a thumbnail
+			const vorbis_info* SectionInfo = ov_info(&Vorbis, Section);
+			if (NumFrames <= 0 || !SectionInfo || SectionInfo->channels != NumChannels)
+			{
+				break;
+			}
+
+			for (int32 Channel = 0; Channel < NumChannels; Channel++)
+			{
+				const float* Source = Channels[Channel];
+				for (long Frame = 0; Frame < NumFrames; Frame++)
+				{
+					Interleaved[Frame * NumChannels + Channel] = Source[Frame];
+				}
+			}
+			Accumulator.AddFrames(Interleaved.GetData(), NumFrames);
+		}
+
+		Accumulator.Finish();
+		return true;
+	}
+#endif
+
+	bool IsSupportedExtension(const FString& Extension)
+	{
+#if FASTASSETS_WITH_VORBIS
+		if (Extension == TEXT("ogg"))
+		{
+			return true;
+		}
+#endif
+		return Extension == TEXT("wav") || Extension == TEXT("aiff") || Extension == TEXT("aif");
+	}
+
+	bool ComputePeaks(const FString& FilePath, const std::atomic<bool>& CancelFlag, FFastAssetsWaveformPeaks& OutPeaks)
+	{
+		TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!File.IsValid())
+		{
+			return false;
+		}
+
+		const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+
+#if FASTASSETS_WITH_VORBIS
+		if (Extension == TEXT("ogg"))
+		{
+			return ReduceOgg(*File, CancelFlag, OutPeaks);
+		}
+#endif
+
+		FPcmLayout Layout;
+		const bool bParsed = Extension == TEXT("wav") ? ParseWav(*File, Layout) : ParseAiff(*File, Layout);
+		return bParsed && ReducePcm(*File, Layout, CancelFlag, OutPeaks);
+	}
+
+	void RenderWaveform(const FFastAssetsWaveformPeaks& Peaks, int32 Width, int32 Height, TArray<uint8>& OutPixels)
+	{
+		OutPixels.SetNumZeroed(Width * Height * 4);
+
+		const int32 NumBuckets = Peaks.Num();
+		if (NumBuckets == 0 || Width <= 0 || Height <= 0)
+		{
+			return;
+		}
+
+		auto Dequantize = [](uint8 Value) { return Value / 255.0f * 2.0f - 1.0f; };
+
+		// Normalize so quiet recordings still fill the tile, but do not blow up near-silence into noise
+		float Loudest = 0.0f;
+		for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+		{
+			Loudest = FMath::Max3(Loudest, FMath::Abs(Dequantize(Peaks.Buckets[Bucket * 4])), FMath::Abs(Dequantize(Peaks.Buckets[Bucket * 4 + 1])));
+		}
+		const float Gain = 1.0f / FMath::Max(Loudest, 0.125f);
+
+		const float Center = Height * 0.5f;
+		const float HalfRange = Height * 0.4f;
+
+		// BGRA8, matching the green of the sound type icon
+		const uint32 PeakColor = 0x4D | (0x99 << 8) | (0x33 << 16) | (0xFFu << 24);
+		const uint32 RmsColor = 0x80 | (0xE6 << 8) | (0x66 << 16) | (0xFFu << 24);
+		uint32* Pixels = (uint32*)OutPixels.GetData();
+
+		for (int32 X = 0; X < Width; X++)
+		{
+			const int32 FirstBucket = (int64)X * NumBuckets / Width;
+			const int32 LastBucket = FMath::Max(FirstBucket + 1, (int32)((int64)(X + 1) * NumBuckets / Width));
+
+			float Low = 1.0f;
+			float High = -1.0f;
+			float Rms = 0.0f;
+			for (int32 Bucket = FirstBucket; Bucket < LastBucket; Bucket++)
+			{
+				Low = FMath::Min(Low, Dequantize(Peaks.Buckets[Bucket * 4]));
+				High = FMath::Max(High, Dequantize(Peaks.Buckets[Bucket * 4 + 1]));
+				Rms = FMath::Max(Rms, Peaks.Buckets[Bucket * 4 + 2] / 255.0f);
+			}
+
+			// Always at least one pixel, so silence still draws a center line
+			const int32 PeakTop = FMath::Clamp(FMath::FloorToInt(Center - High * Gain * HalfRange), 0, Height - 1);
+			const int32 PeakBottom = FMath::Clamp(FMath::CeilToInt(Center - Low * Gain * HalfRange), PeakTop + 1, Height);
+			const int32 RmsTop = FMath::Clamp(FMath::FloorToInt(Center - Rms * Gain * HalfRange), PeakTop, PeakBottom - 1);
+			const int32 RmsBottom = FMath::Clamp(FMath::CeilToInt(Center + Rms * Gain * HalfRange), RmsTop + 1, PeakBottom);
+
+			for (int32 Y = PeakTop; Y < PeakBottom; Y++)
+			{
+				Pixels[(int64)Y * Width + X] = (Y >= RmsTop && Y < RmsBottom) ? RmsColor : PeakColor;
+			}
+		}
+	}
+}
@@ -0,0 +1,244 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsCatalog.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Paths.h"
+#include "Algo/BinarySearch.h"
+
+FString FFastAssetsCatalog::GetCatalogDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("FastAssets") / TEXT("Catalogs");
+}
+
+void FFastAssetsCatalog::DeleteStaleFiles()
+{
+	// Files another editor still has mapped fail to delete, or stay readable until unmapped
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(GetCatalogDirectory() / TEXT("*.*")), true, false);
+	for (const FString& File : Files)
+	{
+		IFileManager::Get().Delete(*(GetCatalogDirectory() / File), false, false, true);
+	}
+}
+
+bool FFastAssetsCatalog::FMappedFile::Map(const FString& InFilePath)
+{
+	FilePath = InFilePath;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.FileSize(*FilePath) <= 0)
+	{
+		return true;
+	}
+
+	FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (MappedResult.HasError())
+	{
+		return false;
+	}
+
+	Handle = MappedResult.StealValue();
+	Region.Reset(Handle->MapRegion());
+	if (!Region.IsValid())
+	{
+		return false;
+	}
+
+	Data = Region->GetMappedPtr();
+	Size = Region->GetMappedSize();
+	return true;
+}
+
+void FFastAssetsCatalog::FMappedFile::Release()
+{
+	// Unmapped first, some platforms refuse to delete a mapped file
+	Region.Reset();
+	Handle.Reset();
+	Data = nullptr;
+	Size = 0;
+
+	if (!FilePath.IsEmpty())
+	{
+		IFileManager::Get().Delete(*FilePath, false, false, true);
+		FilePath.Empty();
+	}
+}
+
+FFastAssetsCatalog::FWriter::FWriter(const FString& RootPath)
+{
+	static const bool bStaleFilesDeleted = []()
+	{
+		DeleteStaleFiles();
+		return true;
+	}();
+
+	const FString Directory = GetCatalogDirectory();
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+	// Unique names, so a rescan can be written while the previous catalog is still mapped
+	FString NormalizedRoot = FPaths::ConvertRelativePathToFull(RootPath).ToLower();
+	FPaths::NormalizeFilename(NormalizedRoot);
+	const FString Prefix = FString::Printf(TEXT("%016llx_"), CityHash64((const char*)*NormalizedRoot, NormalizedRoot.Len() * sizeof(TCHAR)));
+	RecordsPath = FPaths::CreateTempFilename(*Directory, *Prefix, TEXT(".records"));
+	PathsPath = FPaths::CreateTempFilename(*Directory, *Prefix, TEXT(".paths"));
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	RecordsFile.Reset(PlatformFile.OpenWrite(*RecordsPath));
+	PathsFile.Reset(PlatformFile.OpenWrite(*PathsPath));
+	bFailed = !RecordsFile.IsValid() || !PathsFile.IsValid();
+
+	PendingRecords.Reserve(FlushRecords);
+}
+
+FFastAssetsCatalog::FWriter::~FWriter()
+{
+	// Not finished: the scan was cancelled or failed, nothing will map these
+	if (RecordsFile.IsValid() || PathsFile.IsValid())
+	{
+		RecordsFile.Reset();
+		PathsFile.Reset();
+		IFileManager::Get().Delete(*RecordsPath, false, false, true);
+		IFileManager::Get().Delete(*PathsPath, false, false, true);
+	}
+}
+
+void FFastAssetsCatalog::FWriter::AddFile(FStringView FilePath, int64 FileSize, const FDateTime& ModifiedTime, uint8 TypeIndex)
+{
+	if (bFailed || NumRecords == MAX_int32)
+	{
+		return;
+	}
+
+	int32 NameStart = INDEX_NONE;
+	FilePath.FindLastChar(TEXT('/'), NameStart);
+	int32 BackslashStart = INDEX_NONE;
+	FilePath.FindLastChar(TEXT('\\'), BackslashStart);
+
+	FRecord& Record = PendingRecords.AddDefaulted_GetRef();
+	Record.PathOffset = NumPathChars;
+	Record.PathLength = FilePath.Len();
+	Record.NameStart = FMath::Max(NameStart, BackslashStart) + 1;
+	Record.FileSize = FileSize;
+	Record.ModifiedTicks = ModifiedTime.GetTicks();
+	Record.TypeIndex = TypeIndex;
+
+	PendingPaths.Append(FilePath.GetData(), FilePath.Len());
+	NumPathChars += FilePath.Len();
+	NumRecords++;
+
+	if (PendingRecords.Num() >= FlushRecords)
+	{
+		FlushPending();
+	}
+}
+
+void FFastAssetsCatalog::FWriter::FlushPending()
+{
+	if (!bFailed)
+	{
+		bFailed = !RecordsFile->Write((const uint8*)PendingRecords.GetData(), PendingRecords.Num() * sizeof(FRecord)) ||
+			!PathsFile->Write((const uint8*)PendingPaths.GetData(), PendingPaths.Num() * sizeof(TCHAR));
+	}
+
+	PendingRecords.Reset();
+	PendingPaths.Reset();
+}
+
+TSharedPtr<FFastAssetsCatalog> FFastAssetsCatalog::FWriter::Finish()
+{
+	FlushPending();
+	if (bFailed)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to write catalog %s"), *RecordsPath);
+		return nullptr;
+	}
+
+	RecordsFile.Reset();
+	PathsFile.Reset();
+
+	TSharedPtr<FFastAssetsCatalog> Catalog = MakeShareable(new FFastAssetsCatalog());
+	if (!Catalog->RecordsMapping.Map(RecordsPath) || !Catalog->PathsMapping.Map(PathsPath) ||
+		Catalog->RecordsMapping.Size != (int64)NumRecords * sizeof(FRecord) || Catalog->PathsMapping.Size != (int64)(NumPathChars * sizeof(TCHAR)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to map catalog %s"), *RecordsPath);
+		return nullptr;
+	}
+
+	Catalog->Records = (const FRecord*)Catalog->RecordsMapping.Data;
+	Catalog->Paths = (const TCHAR*)Catalog->PathsMapping.Data;
+	Catalog->NumRecords = NumRecords;
+	return Catalog;
+}
+
+FFastAssetsCatalog::~FFastAssetsCatalog()
+{
+	RecordsMapping.Release();
+	PathsMapping.Release();
+}
+
+TSharedPtr<FFastAssetsCatalogView> FFastAssetsCatalogView::Create(const TSharedRef<FFastAssetsCatalog>& InCatalog, const FFastAssetsCatalogView* BaseView, FPredicate Predicate, const std::atomic<bool>& CancelFlag)
+{
+	const FString ResultPath = FPaths::CreateTempFilename(*FFastAssetsCatalog::GetCatalogDirectory(), TEXT("View_"), TEXT(".results"));
+	TUniquePtr<IFileHandle> ResultFile(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*ResultPath));
+	if (!ResultFile.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Matching indices are written out in chunks, so the result never has to fit in memory
+	static constexpr int32 ChunkSize = 16384;
+	TArray<uint32> Chunk;
+	Chunk.Reserve(ChunkSize);
+
+	bool bWritten = true;
+	int32 NumIndices = 0;
+	const int32 NumCandidates = BaseView ? BaseView->Num() : InCatalog->Num();
+	for (int32 Candidate = 0; Candidate < NumCandidates && bWritten; Candidate++)
+	{
+		if ((Candidate & 4095) == 0 && CancelFlag)
+		{
+			bWritten = false;
+			break;
+		}
+
+		const int32 RecordIndex = BaseView ? BaseView->GetRecordIndex(Candidate) : Candidate;
+		const FFastAssetsCatalog::FRecord& Record = InCatalog->GetRecord(RecordIndex);
+		if (Predicate(Record, InCatalog->GetPath(Record)))
+		{
+			Chunk.Add((uint32)RecordIndex);
+			NumIndices++;
+		}
+
+		if (Chunk.Num() == ChunkSize || Candidate == NumCandidates - 1)
+		{
+			bWritten = ResultFile->Write((const uint8*)Chunk.GetData(), Chunk.Num() * sizeof(uint32));
+			Chunk.Reset();
+		}
+	}
+	ResultFile.Reset();
+
+	TSharedPtr<FFastAssetsCatalogView> View = MakeShareable(new FFastAssetsCatalogView(InCatalog));
+	if (!bWritten || !View->Mapping.Map(ResultPath) || View->Mapping.Size != (int64)NumIndices * sizeof(uint32))
+	{
+		View->Mapping.FilePath = ResultPath;
+		return nullptr;
+	}
+
+	View->Indices = (const uint32*)View->Mapping.Data;
+	View->NumIndices = NumIndices;
+	return View;
+}
+
+FFastAssetsCatalogView::~FFastAssetsCatalogView()
+{
+	Mapping.Release();
+}
+
+int32 FFastAssetsCatalogView::Find(int32 RecordIndex) const
+{
+	const int32 Index = Algo::LowerBound(TArrayView<const uint32>(Indices, NumIndices), (uint32)RecordIndex);
+	return Index < NumIndices && Indices[Index] == (uint32)RecordIndex ? Index : INDEX_NONE;
+}
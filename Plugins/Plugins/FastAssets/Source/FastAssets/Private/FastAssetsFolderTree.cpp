@@ -0,0 +1,105 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsFolderTree.h"
+#include "Misc/Paths.h"
+
+const TArray<TSharedPtr<FFastAssetsFolderNode>>& FFastAssetsFolderNode::GetSortedChildren()
+{
+	if (bSortedChildrenDirty)
+	{
+		Children.GenerateValueArray(SortedChildren);
+		SortedChildren.Sort([](const TSharedPtr<FFastAssetsFolderNode>& A, const TSharedPtr<FFastAssetsFolderNode>& B)
+		{
+			return A->Name < B->Name;
+		});
+		bSortedChildrenDirty = false;
+	}
+	return SortedChildren;
+}
+
+FFastAssetsFolderTree::FFastAssetsFolderTree()
+{
+	Reset(FString());
+}
+
+void FFastAssetsFolderTree::Reset(const FString& RootPath)
+{
+	Root = MakeShared<FFastAssetsFolderNode>();
+	Root->Name = FPaths::GetCleanFilename(RootPath.EndsWith(TEXT("/")) || RootPath.EndsWith(TEXT("\\")) ? RootPath.LeftChop(1) : RootPath);
+	Root->Path = RootPath;
+	StructureVersion++;
+}
+
+void FFastAssetsFolderTree::AddFile(const FString& FilePath, int64 FileSize)
+{
+	for (FFastAssetsFolderNode* Node = FindFolder(FilePath, true); Node; Node = Node->Parent)
+	{
+		Node->NumFiles++;
+		Node->TotalSize += FileSize;
+	}
+}
+
+void FFastAssetsFolderTree::RemoveFile(const FString& FilePath, int64 FileSize)
+{
+	FFastAssetsFolderNode* Node = FindFolder(FilePath, false);
+	while (Node)
+	{
+		FFastAssetsFolderNode* Parent = Node->Parent;
+
+		Node->NumFiles--;
+		Node->TotalSize -= FileSize;
+
+		// Anything below an empty folder is empty too and was dropped when it became so
+		if (Node->NumFiles <= 0 && Parent)
+		{
+			// The map may hold the only reference; keep the node alive until it is detached
+			const TSharedPtr<FFastAssetsFolderNode> Removed = Parent->Children.FindRef(Node->Name);
+			Node->Parent = nullptr;
+			Parent->Children.Remove(Node->Name);
+			Parent->bSortedChildrenDirty = true;
+			StructureVersion++;
+		}
+
+		Node = Parent;
+	}
+}
+
+FFastAssetsFolderNode* FFastAssetsFolderTree::FindFolder(const FString& FilePath, bool bCreate)
+{
+	if (!FilePath.StartsWith(Root->Path))
+	{
+		return nullptr;
+	}
+
+	// Every part of the path below the root except the file name is a folder
+	static const TCHAR* Separators[] = { TEXT("/"), TEXT("\\") };
+	TArray<FString> Parts;
+	FilePath.Mid(Root->Path.Len()).ParseIntoArray(Parts, Separators, UE_ARRAY_COUNT(Separators));
+
+	FFastAssetsFolderNode* Node = Root.Get();
+	for (int32 PartIndex = 0; PartIndex < Parts.Num() - 1; PartIndex++)
+	{
+		FString& Part = Parts[PartIndex];
+		if (TSharedPtr<FFastAssetsFolderNode>* Child = Node->Children.Find(Part))
+		{
+			Node = Child->Get();
+			continue;
+		}
+
+		if (!bCreate)
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FFastAssetsFolderNode> NewChild = MakeShared<FFastAssetsFolderNode>();
+		NewChild->Path = Node->Path / Part;
+		NewChild->Name = MoveTemp(Part);
+		NewChild->Parent = Node;
+		Node->Children.Add(NewChild->Name, NewChild);
+		Node->bSortedChildrenDirty = true;
+		StructureVersion++;
+
+		Node = NewChild.Get();
+	}
+	return Node;
+}
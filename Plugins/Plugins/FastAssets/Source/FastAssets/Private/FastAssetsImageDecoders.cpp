@@ -0,0 +1,943 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsImageDecoders.h"
+#include "FastAssetsImageProcessing.h"
+#include "IImageWrapperModule.h"
+#include "IImageWrapper.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+#if FASTASSETS_WITH_LIBJPEGTURBO
+THIRD_PARTY_INCLUDES_START
+#include "turbojpeg.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+#if FASTASSETS_WITH_LIBTIFF
+THIRD_PARTY_INCLUDES_START
+#include "tiffio.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+#if FASTASSETS_WITH_OPENEXR
+THIRD_PARTY_INCLUDES_START
+#include "OpenEXR/ImfRgbaFile.h"
+#include "OpenEXR/ImfTiledRgbaFile.h"
+#include "OpenEXR/ImfTestFile.h"
+#include "Imath/ImathBox.h"
+THIRD_PARTY_INCLUDES_END
+#endif
+
+namespace FastAssetsImageDecoders
+{
+	/** Bounds-checked reads from a TIFF structure in either byte order */
+	struct FTiffReader
+	{
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+		bool bBigEndian = false;
+
+		bool Init(const uint8* InData, int64 InSize)
+		{
+			Data = InData;
+			Size = InSize;
+			if (Size < 8 || !((Data[0] == 'I' && Data[1] == 'I') || (Data[0] == 'M' && Data[1] == 'M')))
+			{
+				return false;
+			}
+			bBigEndian = Data[0] == 'M';
+			return U16(2) == 42;
+		}
+
+		bool InRange(int64 Offset, int64 Length) const
+		{
+			return Offset >= 0 && Length >= 0 && Offset + Length <= Size;
+		}
+
+		uint16 U16(int64 Offset) const
+		{
+			if (!InRange(Offset, 2))
+			{
+				return 0;
+			}
+			return bBigEndian ? (uint16)((Data[Offset] << 8) | Data[Offset + 1]) : (uint16)(Data[Offset] | (Data[Offset + 1] << 8));
+		}
+
+		uint32 U32(int64 Offset) const
+		{
+			if (!InRange(Offset, 4))
+			{
+				return 0;
+			}
+			return bBigEndian
+				? ((uint32)Data[Offset] << 24) | ((uint32)Data[Offset + 1] << 16) | ((uint32)Data[Offset + 2] << 8) | Data[Offset + 3]
+				: Data[Offset] | ((uint32)Data[Offset + 1] << 8) | ((uint32)Data[Offset + 2] << 16) | ((uint32)Data[Offset + 3] << 24);
+		}
+
+		/** Value of a SHORT or LONG tag in the IFD at IfdOffset, or Default if it is missing */
+		uint32 FindTag(int64 IfdOffset, uint16 Tag, uint32 Default) const
+		{
+			const uint16 NumEntries = U16(IfdOffset);
+			for (int32 Index = 0; Index < NumEntries; Index++)
+			{
+				const int64 Entry = IfdOffset + 2 + Index * 12;
+				if (U16(Entry) == Tag)
+				{
+					return U16(Entry + 2) == 3 ? U16(Entry + 8) : U32(Entry + 8);
+				}
+			}
+			return Default;
+		}
+
+		/** Offset of the IFD following the one at IfdOffset (0 if none) */
+		uint32 NextIfd(int64 IfdOffset) const
+		{
+			return U32(IfdOffset + 2 + U16(IfdOffset) * 12);
+		}
+	};
+
+	/** What the marker segments in front of the image data tell us */
+	struct FJpegHeader
+	{
+		int32 Width = 0;
+		int32 Height = 0;
+
+		/** TIFF structure inside the APP1 Exif segment */
+		const uint8* Exif = nullptr;
+		int64 ExifSize = 0;
+	};
+
+	static bool IsStartOfFrame(uint8 Marker)
+	{
+		return Marker >= 0xC0 && Marker <= 0xCF && Marker != 0xC4 && Marker != 0xC8 && Marker != 0xCC;
+	}
+
+	/** Walk the marker segments up to the first scan */
+	static bool ParseJpegHeader(const uint8* Data, int64 Size, FJpegHeader& OutHeader)
+	{
+		if (Size < 4 || Data[0] != 0xFF || Data[1] != 0xD8)
+		{
+			return false;
+		}
+
+		int64 Pos = 2;
+		while (Pos + 4 <= Size)
+		{
+			if (Data[Pos] != 0xFF)
+			{
+				return false;
+			}
+
+			const uint8 Marker = Data[Pos + 1];
+			if (Marker == 0xFF)
+			{
+				// Fill byte
+				Pos++;
+				continue;
+			}
+			Pos += 2;
+
+			if (Marker == 0xDA || Marker == 0xD9)
+			{
+				// Image data follows, no more header segments
+				break;
+			}
+
+			if (Marker == 0x01 || (Marker >= 0xD0 && Marker <= 0xD7))
+			{
+				// Markers without a length
+				continue;
+			}
+
+			const int32 Length = (Data[Pos] << 8) | Data[Pos + 1];
+			if (Length < 2 || Pos + Length > Size)
+			{
+				// Truncated by the head read; keep what we have
+				break;
+			}
+
+			const uint8* Segment = Data + Pos + 2;
+			const int64 SegmentSize = Length - 2;
+
+			if (Marker == 0xE1 && !OutHeader.Exif && SegmentSize > 6 && FMemory::Memcmp(Segment, "Exif\0\0", 6) == 0)
+			{
+				OutHeader.Exif = Segment + 6;
+				OutHeader.ExifSize = SegmentSize - 6;
+			}
+			else if (IsStartOfFrame(Marker) && SegmentSize >= 5)
+			{
+				OutHeader.Height = (Segment[1] << 8) | Segment[2];
+				OutHeader.Width = (Segment[3] << 8) | Segment[4];
+			}
+
+			Pos += Length;
+		}
+
+		return true;
+	}
+
+	bool DecodeExifThumbnail(IImageWrapperModule& WrapperModule, const uint8* Data, int64 Size, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		FJpegHeader Header;
+		if (!ParseJpegHeader(Data, Size, Header) || !Header.Exif || Header.Width <= 0 || Header.Height <= 0)
+		{
+			return false;
+		}
+
+		// The thumbnail lives in IFD1, as a JPEG stream referenced by offset and length
+		FTiffReader Tiff;
+		if (!Tiff.Init(Header.Exif, Header.ExifSize))
+		{
+			return false;
+		}
+
+		const uint32 Ifd1 = Tiff.NextIfd(Tiff.U32(4));
+		if (Ifd1 == 0 || !Tiff.InRange(Ifd1, 2))
+		{
+			return false;
+		}
+
+		const uint32 ThumbnailOffset = Tiff.FindTag(Ifd1, 0x0201, 0);
+		const uint32 ThumbnailLength = Tiff.FindTag(Ifd1, 0x0202, 0);
+		if (ThumbnailLength == 0 || !Tiff.InRange(ThumbnailOffset, ThumbnailLength))
+		{
+			return false;
+		}
+
+		TSharedPtr<IImageWrapper> ImageWrapper = WrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Header.Exif + ThumbnailOffset, ThumbnailLength))
+		{
+			return false;
+		}
+
+		const int32 Width = ImageWrapper->GetWidth();
+		const int32 Height = ImageWrapper->GetHeight();
+
+		// Too small to look sharp at the requested size
+		if (FMath::Max(Width, Height) < MaxSize)
+		{
+			return false;
+		}
+
+		// Cameras often pad previews to 160x120 with black bars; only use ones with the real aspect ratio
+		const double ThumbnailAspect = (double)Width / Height;
+		const double ImageAspect = (double)Header.Width / Header.Height;
+		if (FMath::Abs(ThumbnailAspect - ImageAspect) > ImageAspect * 0.02)
+		{
+			return false;
+		}
+
+		if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutPixels))
+		{
+			OutPixels.Empty();
+			return false;
+		}
+
+		OutWidth = Width;
+		OutHeight = Height;
+		return true;
+	}
+
+	bool DecodeJpegScaled(const uint8* Data, int64 Size, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+#if FASTASSETS_WITH_LIBJPEGTURBO
+		tjhandle Decompressor = tjInitDecompress();
+		if (!Decompressor)
+		{
+			return false;
+		}
+		ON_SCOPE_EXIT
+		{
+			tjDestroy(Decompressor);
+		};
+
+		int Width = 0;
+		int Height = 0;
+		int Subsampling = 0;
+		int ColorSpace = 0;
+		if (tjDecompressHeader3(Decompressor, Data, (unsigned long)Size, &Width, &Height, &Subsampling, &ColorSpace) != 0)
+		{
+			return false;
+		}
+
+		// CMYK cannot be converted to BGRA by turbojpeg; ImageWrapper handles it
+		if (ColorSpace == TJCS_CMYK || ColorSpace == TJCS_YCCK)
+		{
+			return false;
+		}
+
+		// Smallest DCT scale that still covers the thumbnail, so the final area filter only shrinks
+		const FIntPoint Target = FastAssetsImageProcessing::FitWithin(Width, Height, MaxSize);
+
+		int NumFactors = 0;
+		const tjscalingfactor* Factors = tjGetScalingFactors(&NumFactors);
+
+		int32 ScaledWidth = Width;
+		int32 ScaledHeight = Height;
+		for (int32 Index = 0; Factors && Index < NumFactors; Index++)
+		{
+			const tjscalingfactor& Factor = Factors[Index];
+			if (Factor.num > Factor.denom)
+			{
+				continue;
+			}
+
+			const int32 FactorWidth = TJSCALED(Width, Factor);
+			const int32 FactorHeight = TJSCALED(Height, Factor);
+			if (FactorWidth >= Target.X && FactorHeight >= Target.Y && FactorWidth * FactorHeight < ScaledWidth * ScaledHeight)
+			{
+				ScaledWidth = FactorWidth;
+				ScaledHeight = FactorHeight;
+			}
+		}
+
+		OutPixels.SetNumUninitialized((int64)ScaledWidth * ScaledHeight * 4);
+		if (tjDecompress2(Decompressor, Data, (unsigned long)Size, OutPixels.GetData(), ScaledWidth, 0, ScaledHeight, TJPF_BGRA, TJFLAG_FASTDCT) != 0)
+		{
+			OutPixels.Empty();
+			return false;
+		}
+
+		OutWidth = ScaledWidth;
+		OutHeight = ScaledHeight;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/** Sampling step that keeps a Width x Height image at least twice the thumbnail size */
+	static int32 ReductionStep(int32 Width, int32 Height, int32 MaxSize)
+	{
+		const FIntPoint Target = FastAssetsImageProcessing::FitWithin(Width, Height, MaxSize);
+		return FMath::Max(1, FMath::Min(Width / Target.X, Height / Target.Y) / 2);
+	}
+
+#if FASTASSETS_WITH_OPENEXR
+	/** Keep every Step-th pixel of a decoded row */
+	static void DecimateRow(const Imf::Rgba* Row, int32 Width, int32 Step, FFloat16Color* Out)
+	{
+		static_assert(sizeof(Imf::Rgba) == sizeof(FFloat16Color), "Imf::Rgba and FFloat16Color must share a layout");
+		for (int32 X = 0, OutX = 0; X < Width; X += Step, OutX++)
+		{
+			FMemory::Memcpy(&Out[OutX], &Row[X], sizeof(FFloat16Color));
+		}
+	}
+
+	static bool ReadScanlineExr(const char* Path, int32 MaxSize, TArray<FFloat16Color>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		Imf::RgbaInputFile File(Path);
+		const Imath::Box2i DataWindow = File.dataWindow();
+		const int32 Width = DataWindow.max.x - DataWindow.min.x + 1;
+		const int32 Height = DataWindow.max.y - DataWindow.min.y + 1;
+		if (Width <= 0 || Height <= 0)
+		{
+			return false;
+		}
+
+		const int32 Step = ReductionStep(Width, Height, MaxSize);
+		OutWidth = FMath::DivideAndRoundUp(Width, Step);
+		OutHeight = FMath::DivideAndRoundUp(Height, Step);
+		OutPixels.SetNumUninitialized(OutWidth * OutHeight);
+
+		// Read one scanline at a time; OpenEXR only decompresses the blocks that hold the requested lines
+		TArray<Imf::Rgba> Row;
+		Row.SetNumUninitialized(Width);
+		for (int32 OutY = 0; OutY < OutHeight; OutY++)
+		{
+			const int32 Y = DataWindow.min.y + OutY * Step;
+			File.setFrameBuffer(Row.GetData() - DataWindow.min.x - (int64)Y * Width, 1, Width);
+			File.readPixels(Y);
+			DecimateRow(Row.GetData(), Width, Step, OutPixels.GetData() + (int64)OutY * OutWidth);
+		}
+		return true;
+	}
+
+	static bool ReadTiledExr(const char* Path, int32 MaxSize, TArray<FFloat16Color>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		Imf::TiledRgbaInputFile File(Path);
+
+		// Smallest level that still covers the thumbnail; level 0 for files without mips
+		const FIntPoint Target = FastAssetsImageProcessing::FitWithin(File.levelWidth(0), File.levelHeight(0), MaxSize);
+		int32 Level = 0;
+		const int32 NumLevels = FMath::Min(File.numXLevels(), File.numYLevels());
+		while (Level + 1 < NumLevels && File.levelWidth(Level + 1) >= Target.X && File.levelHeight(Level + 1) >= Target.Y)
+		{
+			Level++;
+		}
+
+		const Imath::Box2i DataWindow = File.dataWindowForLevel(Level, Level);
+		const int32 Width = DataWindow.max.x - DataWindow.min.x + 1;
+		const int32 Height = DataWindow.max.y - DataWindow.min.y + 1;
+		if (Width <= 0 || Height <= 0)
+		{
+			return false;
+		}
+
+		const int32 Step = ReductionStep(Width, Height, MaxSize);
+		OutWidth = FMath::DivideAndRoundUp(Width, Step);
+		OutHeight = FMath::DivideAndRoundUp(Height, Step);
+		OutPixels.SetNumUninitialized(OutWidth * OutHeight);
+
+		// Decode one row of tiles at a time, skipping rows of tiles that hold no sampled scanline
+		const int32 TileHeight = File.tileYSize();
+		TArray<Imf::Rgba> Band;
+		Band.SetNumUninitialized(Width * TileHeight);
+
+		int32 OutY = 0;
+		for (int32 TileY = 0; TileY < File.numYTiles(Level) && OutY < OutHeight; TileY++)
+		{
+			const int32 BandTop = TileY * TileHeight;
+			const int32 BandBottom = FMath::Min(BandTop + TileHeight, Height);
+			if (OutY * Step >= BandBottom)
+			{
+				continue;
+			}
+
+			File.setFrameBuffer(Band.GetData() - DataWindow.min.x - (int64)(DataWindow.min.y + BandTop) * Width, 1, Width);
+			File.readTiles(0, File.numXTiles(Level) - 1, TileY, TileY, Level, Level);
+
+			for (; OutY < OutHeight && OutY * Step < BandBottom; OutY++)
+			{
+				DecimateRow(Band.GetData() + (int64)(OutY * Step - BandTop) * Width, Width, Step, OutPixels.GetData() + (int64)OutY * OutWidth);
+			}
+		}
+		return OutY == OutHeight;
+	}
+#endif
+
+	bool DecodeExrReduced(const FString& FilePath, int32 MaxSize, TArray<FFloat16Color>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+#if FASTASSETS_WITH_OPENEXR
+		const FTCHARToUTF8 Path(*FilePath);
+
+		// OpenEXR reports every problem, from a missing file to a corrupt block, by throwing
+		try
+		{
+			bool bTiled = false;
+			if (!Imf::isOpenExrFile(Path.Get(), bTiled))
+			{
+				return false;
+			}
+
+			return bTiled
+				? ReadTiledExr(Path.Get(), MaxSize, OutPixels, OutWidth, OutHeight)
+				: ReadScanlineExr(Path.Get(), MaxSize, OutPixels, OutWidth, OutHeight);
+		}
+		catch (...)
+		{
+			OutPixels.Empty();
+			return false;
+		}
+#else
+		return false;
+#endif
+	}
+
+	/** Big-endian reads from a PSD file */
+	struct FPsdReader
+	{
+		IFileHandle& File;
+		bool bOk = true;
+
+		explicit FPsdReader(IFileHandle& InFile)
+			: File(InFile)
+		{
+		}
+
+		uint64 ReadBE(int32 NumBytes)
+		{
+			uint8 Bytes[8] = {};
+			bOk = bOk && File.Read(Bytes, NumBytes);
+
+			uint64 Value = 0;
+			for (int32 Index = 0; Index < NumBytes; Index++)
+			{
+				Value = (Value << 8) | Bytes[Index];
+			}
+			return Value;
+		}
+
+		uint16 U16() { return (uint16)ReadBE(2); }
+		uint32 U32() { return (uint32)ReadBE(4); }
+		uint64 U64() { return ReadBE(8); }
+
+		void SeekTo(int64 Offset)
+		{
+			bOk = bOk && Offset <= File.Size() && File.Seek(Offset);
+		}
+	};
+
+	/** Photoshop image resource 1036: a JPEG preview behind a 28-byte header */
+	static bool DecodePsdPreview(IImageWrapperModule& WrapperModule, const TArray<uint8>& Resource, int32 MaxSize, int32 ImageWidth, int32 ImageHeight, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		static constexpr int32 PreviewHeaderSize = 28;
+		if (Resource.Num() <= PreviewHeaderSize || Resource[3] != 1)
+		{
+			// Format 1 is JPEG, the only one Photoshop writes
+			return false;
+		}
+
+		TSharedPtr<IImageWrapper> ImageWrapper = WrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(Resource.GetData() + PreviewHeaderSize, Resource.Num() - PreviewHeaderSize))
+		{
+			return false;
+		}
+
+		// Same rules as EXIF previews: sharp enough, and the same shape as the document
+		const int32 Width = ImageWrapper->GetWidth();
+		const int32 Height = ImageWrapper->GetHeight();
+		const double PreviewAspect = (double)Width / FMath::Max(Height, 1);
+		const double ImageAspect = (double)ImageWidth / ImageHeight;
+		if (FMath::Max(Width, Height) < MaxSize || FMath::Abs(PreviewAspect - ImageAspect) > ImageAspect * 0.02)
+		{
+			return false;
+		}
+
+		if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutPixels))
+		{
+			OutPixels.Empty();
+			return false;
+		}
+
+		OutWidth = Width;
+		OutHeight = Height;
+		return true;
+	}
+
+	/** Expand one PackBits row; returns false on malformed data */
+	static bool UnpackBits(const uint8* Src, int32 SrcSize, uint8* Dst, int32 DstSize)
+	{
+		int32 In = 0;
+		int32 Out = 0;
+		while (In < SrcSize && Out < DstSize)
+		{
+			const int8 Header = (int8)Src[In++];
+			if (Header >= 0)
+			{
+				const int32 Count = Header + 1;
+				if (In + Count > SrcSize || Out + Count > DstSize)
+				{
+					return false;
+				}
+				FMemory::Memcpy(Dst + Out, Src + In, Count);
+				In += Count;
+				Out += Count;
+			}
+			else if (Header != -128)
+			{
+				const int32 Count = 1 - Header;
+				if (In >= SrcSize || Out + Count > DstSize)
+				{
+					return false;
+				}
+				FMemory::Memset(Dst + Out, Src[In++], Count);
+				Out += Count;
+			}
+		}
+		return Out == DstSize;
+	}
+
+	bool DecodePsdComposite(IImageWrapperModule& WrapperModule, const FString& FilePath, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!File.IsValid())
+		{
+			return false;
+		}
+		FPsdReader Reader(*File);
+
+		// File header
+		const uint32 Signature = Reader.U32();
+		const uint16 Version = Reader.U16();
+		Reader.SeekTo(12);
+		const int32 NumChannels = Reader.U16();
+		const int32 Height = (int32)Reader.U32();
+		const int32 Width = (int32)Reader.U32();
+		const int32 Depth = Reader.U16();
+		const int32 ColorMode = Reader.U16();
+
+		static constexpr int32 ColorModeGrayscale = 1;
+		static constexpr int32 ColorModeRGB = 3;
+
+		if (!Reader.bOk || Signature != 0x38425053 /* '8BPS' */ || (Version != 1 && Version != 2) || Width <= 0 || Height <= 0)
+		{
+			return false;
+		}
+
+		const int32 NumColorChannels = ColorMode == ColorModeRGB ? 3 : ColorMode == ColorModeGrayscale ? 1 : 0;
+		if (NumColorChannels == 0 || NumChannels < NumColorChannels || (Depth != 8 && Depth != 16))
+		{
+			return false;
+		}
+		const bool bHasAlpha = NumChannels > NumColorChannels;
+
+		// Spec limits; anything beyond them is a corrupt header, and the row tables below are sized from it
+		static constexpr int32 MaxChannels = 56;
+		const int32 MaxSide = Version == 2 ? 300000 : 30000;
+		if (NumChannels > MaxChannels || Width > MaxSide || Height > MaxSide)
+		{
+			return false;
+		}
+
+		// Color mode data, only used by indexed and duotone images
+		const int64 ColorModeLength = Reader.U32();
+		Reader.SeekTo(File->Tell() + ColorModeLength);
+
+		// Image resources: look for the JPEG preview on the way past
+		const int64 ResourcesLength = Reader.U32();
+		const int64 ResourcesStart = File->Tell();
+		const int64 ResourcesEnd = ResourcesStart + ResourcesLength;
+		while (Reader.bOk && File->Tell() + 12 <= ResourcesEnd)
+		{
+			if (Reader.U32() != 0x3842494D /* '8BIM' */)
+			{
+				break;
+			}
+			const uint16 ResourceId = Reader.U16();
+
+			// Pascal string name, padded to an even size including its length byte
+			const int32 NameLength = (int32)Reader.ReadBE(1);
+			Reader.SeekTo(File->Tell() + ((NameLength + 2) & ~1) - 1);
+
+			const int64 ResourceSize = Reader.U32();
+			const int64 ResourceStart = File->Tell();
+
+			if (ResourceId == 1036 && ResourceSize > 0 && ResourceStart + ResourceSize <= ResourcesEnd)
+			{
+				TArray<uint8> Resource;
+				Resource.SetNumUninitialized(ResourceSize);
+				if (File->Read(Resource.GetData(), ResourceSize) &&
+					DecodePsdPreview(WrapperModule, Resource, MaxSize, Width, Height, OutPixels, OutWidth, OutHeight))
+				{
+					return true;
+				}
+			}
+
+			Reader.SeekTo(ResourceStart + ResourceSize + (ResourceSize & 1));
+		}
+
+		// Skip the layer and mask section; this is where the bulk of a layered file lives
+		Reader.SeekTo(ResourcesEnd);
+		const int64 LayersLength = Version == 2 ? (int64)Reader.U64() : (int64)Reader.U32();
+		Reader.SeekTo(File->Tell() + LayersLength);
+
+		// Merged image data, stored channel by channel
+		const uint16 Compression = Reader.U16();
+		if (!Reader.bOk || (Compression != 0 && Compression != 1))
+		{
+			// ZIP compressed composites are rare and would need the whole channel inflated
+			return false;
+		}
+
+		const int64 BytesPerSample = Depth / 8;
+		const int64 RowBytes = Width * BytesPerSample;
+		const int64 TotalRows = (int64)NumChannels * Height;
+
+		// Start of each (channel, row) in the file; RLE rows vary in size, raw rows do not
+		TArray<int64> RowOffsets;
+		TArray<uint32> RowSizes;
+		RowOffsets.SetNumUninitialized(TotalRows);
+		RowSizes.SetNumUninitialized(TotalRows);
+
+		if (Compression == 1)
+		{
+			const int32 CountBytes = Version == 2 ? 4 : 2;
+			TArray<uint8> Counts;
+			Counts.SetNumUninitialized(TotalRows * CountBytes);
+			if (!File->Read(Counts.GetData(), Counts.Num()))
+			{
+				return false;
+			}
+
+			int64 Offset = File->Tell();
+			for (int64 Row = 0; Row < TotalRows; Row++)
+			{
+				const uint8* Count = Counts.GetData() + Row * CountBytes;
+				RowSizes[Row] = CountBytes == 4 ? ((uint32)Count[0] << 24) | ((uint32)Count[1] << 16) | ((uint32)Count[2] << 8) | Count[3] : (uint32)((Count[0] << 8) | Count[1]);
+				if (RowSizes[Row] > RowBytes * 2 + 2)
+				{
+					// PackBits never grows a row this much
+					return false;
+				}
+				RowOffsets[Row] = Offset;
+				Offset += RowSizes[Row];
+			}
+		}
+		else
+		{
+			const int64 DataStart = File->Tell();
+			for (int64 Row = 0; Row < TotalRows; Row++)
+			{
+				RowOffsets[Row] = DataStart + Row * RowBytes;
+				RowSizes[Row] = (uint32)RowBytes;
+			}
+		}
+
+		const int32 Step = ReductionStep(Width, Height, MaxSize);
+		OutWidth = FMath::DivideAndRoundUp(Width, Step);
+		OutHeight = FMath::DivideAndRoundUp(Height, Step);
+		OutPixels.SetNumUninitialized(OutWidth * OutHeight * 4);
+		if (!bHasAlpha)
+		{
+			FMemory::Memset(OutPixels.GetData(), 0xFF, OutPixels.Num());
+		}
+
+		TArray<uint8> Packed;
+		TArray<uint8> Unpacked;
+		Unpacked.SetNumUninitialized(RowBytes);
+
+		// Channel -> BGRA byte: RGB is 0, 1, 2 to R, G, B; grayscale fills all three
+		const int32 NumUsedChannels = NumColorChannels + (bHasAlpha ? 1 : 0);
+		for (int32 Channel = 0; Channel < NumUsedChannels; Channel++)
+		{
+			const bool bAlpha = Channel == NumColorChannels;
+			for (int32 OutY = 0; OutY < OutHeight; OutY++)
+			{
+				const int64 Row = (int64)Channel * Height + (int64)OutY * Step;
+				const uint8* Samples = nullptr;
+
+				if (!File->Seek(RowOffsets[Row]))
+				{
+					return false;
+				}
+
+				if (Compression == 1)
+				{
+					Packed.SetNumUninitialized(RowSizes[Row], EAllowShrinking::No);
+					if (!File->Read(Packed.GetData(), Packed.Num()) || !UnpackBits(Packed.GetData(), Packed.Num(), Unpacked.GetData(), RowBytes))
+					{
+						return false;
+					}
+				}
+				else if (!File->Read(Unpacked.GetData(), RowBytes))
+				{
+					return false;
+				}
+				Samples = Unpacked.GetData();
+
+				// 16-bit samples are big-endian, so the first byte is the high byte
+				uint8* Dst = OutPixels.GetData() + (int64)OutY * OutWidth * 4;
+				for (int32 OutX = 0; OutX < OutWidth; OutX++, Dst += 4)
+				{
+					const uint8 Value = Samples[(int64)OutX * Step * BytesPerSample];
+					if (bAlpha)
+					{
+						Dst[3] = Value;
+					}
+					else if (NumColorChannels == 1)
+					{
+						Dst[0] = Dst[1] = Dst[2] = Value;
+					}
+					else
+					{
+						Dst[2 - Channel] = Value;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+#if FASTASSETS_WITH_LIBTIFF
+	/** libtiff I/O over an IFileHandle, so paths and large files work the same on every platform */
+	static tmsize_t TiffRead(thandle_t Handle, void* Buffer, tmsize_t Size)
+	{
+		IFileHandle* File = (IFileHandle*)Handle;
+		const int64 Bytes = FMath::Min<int64>(Size, File->Size() - File->Tell());
+		return Bytes > 0 && File->Read((uint8*)Buffer, Bytes) ? (tmsize_t)Bytes : 0;
+	}
+
+	static tmsize_t TiffWrite(thandle_t, void*, tmsize_t)
+	{
+		return 0;
+	}
+
+	static toff_t TiffSeek(thandle_t Handle, toff_t Offset, int Origin)
+	{
+		IFileHandle* File = (IFileHandle*)Handle;
+		const int64 Position = Origin == SEEK_SET ? (int64)Offset : Origin == SEEK_CUR ? File->Tell() + (int64)Offset : File->Size() + (int64)Offset;
+		return File->Seek(Position) ? (toff_t)Position : (toff_t)-1;
+	}
+
+	static int TiffClose(thandle_t)
+	{
+		return 0;
+	}
+
+	static toff_t TiffSize(thandle_t Handle)
+	{
+		return (toff_t)((IFileHandle*)Handle)->Size();
+	}
+
+	static int TiffMap(thandle_t, void**, toff_t*)
+	{
+		return 0;
+	}
+
+	static void TiffUnmap(thandle_t, void*, toff_t)
+	{
+	}
+#endif
+
+	bool DecodeTiffReduced(const FString& FilePath, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+#if FASTASSETS_WITH_LIBTIFF
+		TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+		if (!File.IsValid())
+		{
+			return false;
+		}
+
+		TIFF* Tiff = TIFFClientOpen("FastAssets", "rm", (thandle_t)File.Get(), TiffRead, TiffWrite, TiffSeek, TiffClose, TiffSize, TiffMap, TiffUnmap);
+		if (!Tiff)
+		{
+			return false;
+		}
+		ON_SCOPE_EXIT
+		{
+			TIFFClose(Tiff);
+		};
+
+		uint32 FullWidth = 0;
+		uint32 FullHeight = 0;
+		TIFFGetField(Tiff, TIFFTAG_IMAGEWIDTH, &FullWidth);
+		TIFFGetField(Tiff, TIFFTAG_IMAGELENGTH, &FullHeight);
+		// Sides are kept to what int32 pixel math and a band of rows can hold
+		static constexpr uint32 MaxTiffSide = 1 << 20;
+		if (FullWidth == 0 || FullHeight == 0 || FullWidth > MaxTiffSide || FullHeight > MaxTiffSide)
+		{
+			return false;
+		}
+		const FIntPoint Target = FastAssetsImageProcessing::FitWithin(FullWidth, FullHeight, MaxSize);
+
+		// Candidates: the first IFD, reduced images that follow it, and reduced images in its SubIFDs
+		uint64 BestOffset = TIFFCurrentDirOffset(Tiff);
+		uint64 BestPixels = (uint64)FullWidth * FullHeight;
+		TArray<uint64> SubIfds;
+		{
+			uint16 NumSubIfds = 0;
+			uint64* SubIfdOffsets = nullptr;
+			if (TIFFGetField(Tiff, TIFFTAG_SUBIFD, &NumSubIfds, &SubIfdOffsets) && SubIfdOffsets)
+			{
+				SubIfds.Append(SubIfdOffsets, NumSubIfds);
+			}
+		}
+
+		auto ConsiderCurrent = [&]()
+		{
+			uint32 Width = 0;
+			uint32 Height = 0;
+			uint32 SubfileType = 0;
+			TIFFGetField(Tiff, TIFFTAG_IMAGEWIDTH, &Width);
+			TIFFGetField(Tiff, TIFFTAG_IMAGELENGTH, &Height);
+			TIFFGetFieldDefaulted(Tiff, TIFFTAG_SUBFILETYPE, &SubfileType);
+
+			const uint64 Pixels = (uint64)Width * Height;
+			if ((SubfileType & FILETYPE_REDUCEDIMAGE) && (int32)Width >= Target.X && (int32)Height >= Target.Y && Pixels < BestPixels)
+			{
+				BestOffset = TIFFCurrentDirOffset(Tiff);
+				BestPixels = Pixels;
+			}
+		};
+
+		while (TIFFReadDirectory(Tiff))
+		{
+			ConsiderCurrent();
+		}
+		for (uint64 SubIfd : SubIfds)
+		{
+			if (TIFFSetSubDirectory(Tiff, SubIfd))
+			{
+				ConsiderCurrent();
+			}
+		}
+
+		if (!TIFFSetSubDirectory(Tiff, BestOffset))
+		{
+			return false;
+		}
+
+		char Error[1024] = {};
+		TIFFRGBAImage Image;
+		if (!TIFFRGBAImageOK(Tiff, Error) || !TIFFRGBAImageBegin(&Image, Tiff, 0, Error))
+		{
+			return false;
+		}
+		ON_SCOPE_EXIT
+		{
+			TIFFRGBAImageEnd(&Image);
+		};
+		Image.req_orientation = ORIENTATION_TOPLEFT;
+
+		if (Image.width == 0 || Image.height == 0 || Image.width > MaxTiffSide || Image.height > MaxTiffSide)
+		{
+			return false;
+		}
+
+		const int32 Width = (int32)Image.width;
+		const int32 Height = (int32)Image.height;
+		const int32 Step = ReductionStep(Width, Height, MaxSize);
+		OutWidth = FMath::DivideAndRoundUp(Width, Step);
+		OutHeight = FMath::DivideAndRoundUp(Height, Step);
+		OutPixels.SetNumUninitialized(OutWidth * OutHeight * 4);
+
+		// Decode one strip or row of tiles at a time, skipping bands that hold no sampled row
+		uint32 BandRows = 0;
+		if (TIFFIsTiled(Tiff))
+		{
+			TIFFGetField(Tiff, TIFFTAG_TILELENGTH, &BandRows);
+		}
+		else
+		{
+			TIFFGetFieldDefaulted(Tiff, TIFFTAG_ROWSPERSTRIP, &BandRows);
+		}
+
+		// A single-strip file has one band as tall as the image; cap it, at the cost of libtiff decoding
+		// that strip again from its start for each band
+		static constexpr int64 MaxBandPixels = 4 * 1024 * 1024;
+		BandRows = FMath::Clamp<uint32>(BandRows, 1, (uint32)FMath::Clamp<int64>(MaxBandPixels / Width, 1, Height));
+
+		TArray<uint32> Band;
+		Band.SetNumUninitialized((int64)Width * BandRows);
+
+		int32 OutY = 0;
+		for (int32 BandTop = 0; BandTop < Height && OutY < OutHeight; BandTop += BandRows)
+		{
+			const int32 NumRows = FMath::Min<int32>(BandRows, Height - BandTop);
+			if (OutY * Step >= BandTop + NumRows)
+			{
+				continue;
+			}
+
+			Image.row_offset = BandTop;
+			Image.col_offset = 0;
+			if (!TIFFRGBAImageGet(&Image, Band.GetData(), Width, NumRows))
+			{
+				return false;
+			}
+
+			// Raster pixels are packed ABGR, i.e. R, G, B, A bytes in memory
+			for (; OutY < OutHeight && OutY * Step < BandTop + NumRows; OutY++)
+			{
+				const uint32* Src = Band.GetData() + (int64)(OutY * Step - BandTop) * Width;
+				uint8* Dst = OutPixels.GetData() + (int64)OutY * OutWidth * 4;
+				for (int32 OutX = 0; OutX < OutWidth; OutX++, Dst += 4)
+				{
+					const uint32 Pixel = Src[(int64)OutX * Step];
+					Dst[0] = (uint8)TIFFGetB(Pixel);
+					Dst[1] = (uint8)TIFFGetG(Pixel);
+					Dst[2] = (uint8)TIFFGetR(Pixel);
+					Dst[3] = (uint8)TIFFGetA(Pixel);
+				}
+			}
+		}
+
+		return OutY == OutHeight;
+#else
+		return false;
+#endif
+	}
+}
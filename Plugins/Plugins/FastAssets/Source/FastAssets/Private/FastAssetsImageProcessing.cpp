@@ -0,0 +1,304 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsImageProcessing.h"
+
+namespace FastAssetsImageProcessing
+{
+	typedef TArray<VectorRegister4Float, TAlignedHeapAllocator<16>> FVectorArray;
+
+	/** Source span and weights for each destination pixel along one axis */
+	struct FAreaTaps
+	{
+		TArray<int32> First;
+		TArray<int32> Count;
+		TArray<int32> WeightOffset;
+		TArray<float> Weights;
+
+		void Build(int32 SrcSize, int32 DstSize)
+		{
+			const double Scale = (double)SrcSize / DstSize;
+
+			First.SetNumUninitialized(DstSize);
+			Count.SetNumUninitialized(DstSize);
+			WeightOffset.SetNumUninitialized(DstSize);
+			Weights.Reset(SrcSize + DstSize * 2);
+
+			for (int32 D = 0; D < DstSize; D++)
+			{
+				const double Begin = D * Scale;
+				const double End = FMath::Min((D + 1) * Scale, (double)SrcSize);
+				const int32 FirstSrc = FMath::FloorToInt(Begin);
+				const int32 LastSrc = FMath::Min(FMath::CeilToInt(End), SrcSize) - 1;
+
+				First[D] = FirstSrc;
+				Count[D] = LastSrc - FirstSrc + 1;
+				WeightOffset[D] = Weights.Num();
+
+				// Weight is the covered fraction of each source pixel, normalized by the footprint
+				for (int32 S = FirstSrc; S <= LastSrc; S++)
+				{
+					const double Covered = FMath::Min(End, (double)(S + 1)) - FMath::Max(Begin, (double)S);
+					Weights.Add((float)(Covered / Scale));
+				}
+			}
+		}
+	};
+
+	/** Load one BGRA8 pixel as floats with color premultiplied by alpha */
+	FORCEINLINE VectorRegister4Float LoadPremultiplied(const uint8* Pixel)
+	{
+		const float Alpha = Pixel[3] * (1.0f / 255.0f);
+		return VectorMultiply(VectorLoadByte4(Pixel), MakeVectorRegisterFloat(Alpha, Alpha, Alpha, 1.0f));
+	}
+
+	/** Resample one source row horizontally into DstWidth premultiplied pixels */
+	static void ResampleRow(const uint8* SrcRow, const FAreaTaps& TapsX, const FVectorArray& WeightsX, VectorRegister4Float* OutRow, int32 DstWidth)
+	{
+		for (int32 X = 0; X < DstWidth; X++)
+		{
+			const uint8* Pixel = SrcRow + TapsX.First[X] * 4;
+			const VectorRegister4Float* Weight = WeightsX.GetData() + TapsX.WeightOffset[X];
+
+			VectorRegister4Float Acc = VectorZeroFloat();
+			for (int32 Tap = 0; Tap < TapsX.Count[X]; Tap++, Pixel += 4)
+			{
+				Acc = VectorMultiplyAdd(LoadPremultiplied(Pixel), Weight[Tap], Acc);
+			}
+			OutRow[X] = Acc;
+		}
+	}
+
+	FIntPoint FitWithin(int32 Width, int32 Height, int32 MaxSize)
+	{
+		if (Width <= 0 || Height <= 0 || (Width <= MaxSize && Height <= MaxSize))
+		{
+			return FIntPoint(Width, Height);
+		}
+
+		if (Width > Height)
+		{
+			return FIntPoint(MaxSize, FMath::Max(1, FMath::RoundToInt((float)MaxSize * Height / Width)));
+		}
+		return FIntPoint(FMath::Max(1, FMath::RoundToInt((float)MaxSize * Width / Height)), MaxSize);
+	}
+
+	void DownscaleBGRA8(const uint8* Src, int32 SrcWidth, int32 SrcHeight, uint8* Dst, int32 DstWidth, int32 DstHeight)
+	{
+		check(Src && Dst);
+		check(DstWidth > 0 && DstHeight > 0 && DstWidth <= SrcWidth && DstHeight <= SrcHeight);
+
+		FAreaTaps TapsX;
+		FAreaTaps TapsY;
+		TapsX.Build(SrcWidth, DstWidth);
+		TapsY.Build(SrcHeight, DstHeight);
+
+		// Splat horizontal weights once so the inner loop is a pure multiply-add
+		FVectorArray WeightsX;
+		WeightsX.SetNumUninitialized(TapsX.Weights.Num());
+		for (int32 Index = 0; Index < TapsX.Weights.Num(); Index++)
+		{
+			WeightsX[Index] = VectorSetFloat1(TapsX.Weights[Index]);
+		}
+
+		FVectorArray RowBuffer;
+		FVectorArray Accumulator;
+		RowBuffer.SetNumUninitialized(DstWidth);
+		Accumulator.SetNumUninitialized(DstWidth);
+
+		const int32 SrcStride = SrcWidth * 4;
+
+		// Stream source rows through a single destination row accumulator, so memory stays at O(DstWidth)
+		for (int32 Y = 0; Y < DstHeight; Y++)
+		{
+			for (int32 X = 0; X < DstWidth; X++)
+			{
+				Accumulator[X] = VectorZeroFloat();
+			}
+
+			for (int32 Tap = 0; Tap < TapsY.Count[Y]; Tap++)
+			{
+				const int32 SrcY = TapsY.First[Y] + Tap;
+				const VectorRegister4Float WeightY = VectorSetFloat1(TapsY.Weights[TapsY.WeightOffset[Y] + Tap]);
+
+				ResampleRow(Src + (int64)SrcY * SrcStride, TapsX, WeightsX, RowBuffer.GetData(), DstWidth);
+
+				for (int32 X = 0; X < DstWidth; X++)
+				{
+					Accumulator[X] = VectorMultiplyAdd(RowBuffer[X], WeightY, Accumulator[X]);
+				}
+			}
+
+			// Un-premultiply and round back to bytes
+			uint8* DstRow = Dst + (int64)Y * DstWidth * 4;
+			for (int32 X = 0; X < DstWidth; X++)
+			{
+				alignas(16) float Pixel[4];
+				VectorStoreAligned(Accumulator[X], Pixel);
+
+				const float Alpha = Pixel[3];
+				const float ColorScale = Alpha > 0.5f ? 255.0f / Alpha : 0.0f;
+
+				DstRow[X * 4 + 0] = (uint8)FMath::Clamp(FMath::RoundToInt(Pixel[0] * ColorScale), 0, 255);
+				DstRow[X * 4 + 1] = (uint8)FMath::Clamp(FMath::RoundToInt(Pixel[1] * ColorScale), 0, 255);
+				DstRow[X * 4 + 2] = (uint8)FMath::Clamp(FMath::RoundToInt(Pixel[2] * ColorScale), 0, 255);
+				DstRow[X * 4 + 3] = (uint8)FMath::Clamp(FMath::RoundToInt(Alpha), 0, 255);
+			}
+		}
+	}
+
+	bool ShrinkToFit(TArray<uint8>& Pixels, int32& Width, int32& Height, int32 MaxSize)
+	{
+		const FIntPoint TargetSize = FitWithin(Width, Height, MaxSize);
+		if (TargetSize.X == Width && TargetSize.Y == Height)
+		{
+			return false;
+		}
+
+		check(Pixels.Num() >= Width * Height * 4);
+
+		TArray<uint8> Scaled;
+		Scaled.SetNumUninitialized(TargetSize.X * TargetSize.Y * 4);
+		DownscaleBGRA8(Pixels.GetData(), Width, Height, Scaled.GetData(), TargetSize.X, TargetSize.Y);
+
+		Pixels = MoveTemp(Scaled);
+		Width = TargetSize.X;
+		Height = TargetSize.Y;
+		return true;
+	}
+
+	/** Source pixels sampled per axis for each thumbnail pixel; enough to hide aliasing without touching every source pixel */
+	static constexpr int32 MaxLinearTaps = 4;
+
+	/** Reduce a linear image with a box of at most MaxLinearTaps x MaxLinearTaps evenly spread samples per output pixel */
+	template <typename LoadPixelType>
+	static void DownscaleLinear(int32 SrcWidth, int32 SrcHeight, int32 DstWidth, int32 DstHeight, LoadPixelType LoadPixel, TArray<FLinearColor>& OutPixels)
+	{
+		OutPixels.SetNumUninitialized(DstWidth * DstHeight);
+
+		for (int32 Y = 0; Y < DstHeight; Y++)
+		{
+			const int32 FirstY = (int64)Y * SrcHeight / DstHeight;
+			const int32 SpanY = FMath::Max(1, (int32)((int64)(Y + 1) * SrcHeight / DstHeight) - FirstY);
+			const int32 TapsY = FMath::Min(SpanY, MaxLinearTaps);
+
+			for (int32 X = 0; X < DstWidth; X++)
+			{
+				const int32 FirstX = (int64)X * SrcWidth / DstWidth;
+				const int32 SpanX = FMath::Max(1, (int32)((int64)(X + 1) * SrcWidth / DstWidth) - FirstX);
+				const int32 TapsX = FMath::Min(SpanX, MaxLinearTaps);
+
+				VectorRegister4Float Sum = VectorZeroFloat();
+				for (int32 TapY = 0; TapY < TapsY; TapY++)
+				{
+					const int32 SrcY = FirstY + (2 * TapY + 1) * SpanY / (2 * TapsY);
+					for (int32 TapX = 0; TapX < TapsX; TapX++)
+					{
+						const int32 SrcX = FirstX + (2 * TapX + 1) * SpanX / (2 * TapsX);
+						Sum = VectorAdd(Sum, LoadPixel(SrcX, SrcY));
+					}
+				}
+
+				VectorStore(VectorMultiply(Sum, VectorSetFloat1(1.0f / (TapsX * TapsY))), &OutPixels[(int64)Y * DstWidth + X].R);
+			}
+		}
+	}
+
+	/** Linear [0, 1] to sRGB bytes, indexed by value * (Size - 1) */
+	struct FSrgbTable
+	{
+		static constexpr int32 Size = 4096;
+		uint8 Values[Size];
+
+		FSrgbTable()
+		{
+			for (int32 Index = 0; Index < Size; Index++)
+			{
+				const float Linear = (float)Index / (Size - 1);
+				const float Encoded = Linear <= 0.0031308f ? Linear * 12.92f : 1.055f * FMath::Pow(Linear, 1.0f / 2.4f) - 0.055f;
+				Values[Index] = (uint8)FMath::Clamp(FMath::RoundToInt(Encoded * 255.0f), 0, 255);
+			}
+		}
+	};
+
+	/** Largest linear value kept; HDR files may hold Inf, which would turn the exposure and the mapping into NaN */
+	static constexpr float MaxLinearValue = 65504.0f;
+
+	/** Tone map linear pixels into sRGB BGRA8; NaN, Inf and negative values are clamped in place first */
+	static void ToneMapToBGRA8(TArray<FLinearColor>& Linear, TArray<uint8>& OutPixels)
+	{
+		static const FSrgbTable SrgbTable;
+
+		for (FLinearColor& Pixel : Linear)
+		{
+			for (float* Channel : { &Pixel.R, &Pixel.G, &Pixel.B, &Pixel.A })
+			{
+				*Channel = FMath::IsNaN(*Channel) ? 0.0f : FMath::Clamp(*Channel, 0.0f, MaxLinearValue);
+			}
+		}
+
+		// Exposure from the log-average luminance, so both bright skies and dim interiors land mid-grey
+		double LogSum = 0.0;
+		for (const FLinearColor& Pixel : Linear)
+		{
+			const float Luminance = 0.2126f * Pixel.R + 0.7152f * Pixel.G + 0.0722f * Pixel.B;
+			LogSum += FMath::Loge(Luminance + 1e-4f);
+		}
+		const float AverageLuminance = (float)FMath::Exp(LogSum / FMath::Max(Linear.Num(), 1));
+		const float Exposure = FMath::Clamp(0.18f / FMath::Max(AverageLuminance, 1e-4f), 1.0f / 64.0f, 64.0f);
+
+		const VectorRegister4Float Scale = MakeVectorRegisterFloat(Exposure, Exposure, Exposure, 1.0f);
+		const VectorRegister4Float One = VectorOneFloat();
+		const VectorRegister4Float Zero = VectorZeroFloat();
+		const VectorRegister4Float AlphaMask = MakeVectorRegisterFloatMask(0, 0, 0, 0xFFFFFFFF);
+		const VectorRegister4Float TableScale = VectorSetFloat1((float)(FSrgbTable::Size - 1));
+
+		OutPixels.SetNumUninitialized(Linear.Num() * 4);
+		uint8* Dst = OutPixels.GetData();
+
+		for (int32 Index = 0; Index < Linear.Num(); Index++, Dst += 4)
+		{
+			// Reinhard on color: x / (1 + x) after exposure; alpha is only clamped
+			const VectorRegister4Float Exposed = VectorMax(VectorMultiply(VectorLoad(&Linear[Index].R), Scale), Zero);
+			const VectorRegister4Float Mapped = VectorSelect(AlphaMask, VectorMin(Exposed, One), VectorDivide(Exposed, VectorAdd(Exposed, One)));
+
+			alignas(16) float Values[4];
+			VectorStoreAligned(VectorMultiply(Mapped, TableScale), Values);
+
+			Dst[0] = SrgbTable.Values[FMath::Clamp((int32)(Values[2] + 0.5f), 0, FSrgbTable::Size - 1)];
+			Dst[1] = SrgbTable.Values[FMath::Clamp((int32)(Values[1] + 0.5f), 0, FSrgbTable::Size - 1)];
+			Dst[2] = SrgbTable.Values[FMath::Clamp((int32)(Values[0] + 0.5f), 0, FSrgbTable::Size - 1)];
+			Dst[3] = (uint8)FMath::Clamp((int32)(Values[3] * (255.0f / (FSrgbTable::Size - 1)) + 0.5f), 0, 255);
+		}
+	}
+
+	void ToneMapHalf(const FFloat16Color* Src, int32 SrcWidth, int32 SrcHeight, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		const FIntPoint TargetSize = FitWithin(SrcWidth, SrcHeight, MaxSize);
+
+		TArray<FLinearColor> Linear;
+		DownscaleLinear(SrcWidth, SrcHeight, TargetSize.X, TargetSize.Y, [Src, SrcWidth](int32 X, int32 Y)
+		{
+			const FLinearColor Pixel(Src[(int64)Y * SrcWidth + X]);
+			return VectorLoad(&Pixel.R);
+		}, Linear);
+
+		ToneMapToBGRA8(Linear, OutPixels);
+		OutWidth = TargetSize.X;
+		OutHeight = TargetSize.Y;
+	}
+
+	void ToneMapFloat(const FLinearColor* Src, int32 SrcWidth, int32 SrcHeight, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+	{
+		const FIntPoint TargetSize = FitWithin(SrcWidth, SrcHeight, MaxSize);
+
+		TArray<FLinearColor> Linear;
+		DownscaleLinear(SrcWidth, SrcHeight, TargetSize.X, TargetSize.Y, [Src, SrcWidth](int32 X, int32 Y)
+		{
+			return VectorLoad(&Src[(int64)Y * SrcWidth + X].R);
+		}, Linear);
+
+		ToneMapToBGRA8(Linear, OutPixels);
+		OutWidth = TargetSize.X;
+		OutHeight = TargetSize.Y;
+	}
+}
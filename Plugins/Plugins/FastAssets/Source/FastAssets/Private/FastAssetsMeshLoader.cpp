@@ -0,0 +1,577 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsMeshLoader.h"
+#include "Dom/JsonObject.h"
+#include "GenericPlatform/GenericPlatformHttp.h"
+#include "HAL/FileManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace FastAssetsMeshLoader
+{
+	/** Files larger than this are not parsed at all */
+	static constexpr int64 MaxMeshFileBytes = 512ll * 1024 * 1024;
+
+	/** Keep one triangle in Stride so at most MaxTriangles remain */
+	static int32 GetTriangleStride(int64 NumTriangles, int32 MaxTriangles)
+	{
+		return (int32)FMath::Max<int64>(1, FMath::DivideAndRoundUp<int64>(NumTriangles, FMath::Max(MaxTriangles, 1)));
+	}
+
+	static bool LoadFileCapped(const FString& FilePath, TArray<uint8>& OutData)
+	{
+		const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+		if (FileSize <= 0 || FileSize > MaxMeshFileBytes)
+		{
+			return false;
+		}
+		return FFileHelper::LoadFileToArray(OutData, *FilePath);
+	}
+
+	bool IsSupportedExtension(const FString& Extension)
+	{
+		return Extension == TEXT("obj") || Extension == TEXT("gltf") || Extension == TEXT("glb");
+	}
+
+	bool LoadMesh(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh)
+	{
+		const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+		if (Extension == TEXT("obj"))
+		{
+			return LoadObj(FilePath, MaxTriangles, OutMesh);
+		}
+		if (Extension == TEXT("gltf") || Extension == TEXT("glb"))
+		{
+			return LoadGltf(FilePath, MaxTriangles, OutMesh);
+		}
+		return false;
+	}
+
+	// ========== OBJ ==========
+
+	static FORCEINLINE bool IsObjSpace(ANSICHAR Char)
+	{
+		return Char == ' ' || Char == '\t';
+	}
+
+	static FORCEINLINE const ANSICHAR* SkipObjSpaces(const ANSICHAR* Cursor)
+	{
+		while (IsObjSpace(*Cursor))
+		{
+			Cursor++;
+		}
+		return Cursor;
+	}
+
+	static FORCEINLINE const ANSICHAR* SkipObjToken(const ANSICHAR* Cursor)
+	{
+		while (*Cursor && !IsObjSpace(*Cursor) && *Cursor != '\n' && *Cursor != '\r')
+		{
+			Cursor++;
+		}
+		return Cursor;
+	}
+
+	bool LoadObj(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh)
+	{
+		TArray<uint8> FileData;
+		if (!LoadFileCapped(FilePath, FileData))
+		{
+			return false;
+		}
+		FileData.Add(0);
+
+		const ANSICHAR* Text = (const ANSICHAR*)FileData.GetData();
+		const ANSICHAR* TextEnd = Text + FileData.Num() - 1;
+
+		// Count faces first so the subsampling stride is known before parsing them
+		int64 NumFaces = 0;
+		int64 NumVertices = 0;
+		for (const ANSICHAR* Line = Text; Line < TextEnd; )
+		{
+			if (Line[0] == 'f' && IsObjSpace(Line[1]))
+			{
+				NumFaces++;
+			}
+			else if (Line[0] == 'v' && IsObjSpace(Line[1]))
+			{
+				NumVertices++;
+			}
+
+			const ANSICHAR* NextLine = (const ANSICHAR*)FMemory::Memchr(Line, '\n', TextEnd - Line);
+			Line = NextLine ? NextLine + 1 : TextEnd;
+		}
+
+		if (NumFaces == 0 || NumVertices == 0)
+		{
+			return false;
+		}
+
+		const int32 FaceStride = GetTriangleStride(NumFaces, MaxTriangles);
+
+		OutMesh.Positions.Reserve(NumVertices);
+		OutMesh.Indices.Reserve(FMath::Min<int64>(NumFaces / FaceStride + 1, MaxTriangles) * 3);
+
+		int64 FaceIndex = 0;
+		TArray<int32, TInlineAllocator<16>> FaceVertices;
+
+		for (const ANSICHAR* Line = Text; Line < TextEnd; )
+		{
+			const ANSICHAR* NextLine = (const ANSICHAR*)FMemory::Memchr(Line, '\n', TextEnd - Line);
+			NextLine = NextLine ? NextLine + 1 : TextEnd;
+
+			if (Line[0] == 'v' && IsObjSpace(Line[1]))
+			{
+				float Coords[3] = { 0.0f, 0.0f, 0.0f };
+				const ANSICHAR* Cursor = Line + 2;
+				for (int32 Axis = 0; Axis < 3; Axis++)
+				{
+					Cursor = SkipObjSpaces(Cursor);
+					Coords[Axis] = FCStringAnsi::Atof(Cursor);
+					Cursor = SkipObjToken(Cursor);
+				}
+				OutMesh.Positions.Emplace(Coords[0], Coords[1], Coords[2]);
+			}
+			else if (Line[0] == 'f' && IsObjSpace(Line[1]))
+			{
+				if (FaceIndex++ % FaceStride == 0)
+				{
+					// Vertex references are "v", "v/vt", "v//vn" or "v/vt/vn"; only v matters, negative is relative
+					FaceVertices.Reset();
+					const ANSICHAR* Cursor = SkipObjSpaces(Line + 2);
+					while (Cursor < NextLine && *Cursor && *Cursor != '\n' && *Cursor != '\r')
+					{
+						const int32 Reference = FCStringAnsi::Atoi(Cursor);
+						const int32 VertexIndex = Reference < 0 ? OutMesh.Positions.Num() + Reference : Reference - 1;
+						if (VertexIndex >= 0 && VertexIndex < OutMesh.Positions.Num())
+						{
+							FaceVertices.Add(VertexIndex);
+						}
+						Cursor = SkipObjSpaces(SkipObjToken(Cursor));
+					}
+
+					for (int32 Corner = 2; Corner < FaceVertices.Num(); Corner++)
+					{
+						OutMesh.Indices.Add(FaceVertices[0]);
+						OutMesh.Indices.Add(FaceVertices[Corner - 1]);
+						OutMesh.Indices.Add(FaceVertices[Corner]);
+					}
+				}
+			}
+
+			Line = NextLine;
+		}
+
+		return OutMesh.Indices.Num() > 0;
+	}
+
+	// ========== glTF ==========
+
+	/** Parsed document and the buffers it references */
+	struct FGltfDocument
+	{
+		TSharedPtr<FJsonObject> Root;
+		FString BaseDirectory;
+
+		/** Binary chunk of a .glb, used for the buffer without a uri */
+		TArray<uint8> BinaryChunk;
+
+		TArray<TArray<uint8>> Buffers;
+		TArray<bool> BuffersLoaded;
+
+		const TArray<TSharedPtr<FJsonValue>>* GetArray(const TCHAR* Name) const
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+			return Root->TryGetArrayField(Name, Array) ? Array : nullptr;
+		}
+
+		TSharedPtr<FJsonObject> GetElement(const TCHAR* ArrayName, int32 Index) const
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Array = GetArray(ArrayName);
+			if (!Array || !Array->IsValidIndex(Index))
+			{
+				return nullptr;
+			}
+			return (*Array)[Index]->AsObject();
+		}
+
+		const TArray<uint8>* GetBuffer(int32 BufferIndex)
+		{
+			TSharedPtr<FJsonObject> Buffer = GetElement(TEXT("buffers"), BufferIndex);
+			if (!Buffer.IsValid())
+			{
+				return nullptr;
+			}
+
+			if (Buffers.Num() <= BufferIndex)
+			{
+				Buffers.SetNum(BufferIndex + 1);
+				BuffersLoaded.SetNumZeroed(BufferIndex + 1);
+			}
+
+			if (!BuffersLoaded[BufferIndex])
+			{
+				BuffersLoaded[BufferIndex] = true;
+
+				FString Uri;
+				if (!Buffer->TryGetStringField(TEXT("uri"), Uri))
+				{
+					Buffers[BufferIndex] = MoveTemp(BinaryChunk);
+				}
+				else if (Uri.StartsWith(TEXT("data:")))
+				{
+					int32 CommaIndex = INDEX_NONE;
+					if (Uri.FindChar(TEXT(','), CommaIndex))
+					{
+						FBase64::Decode(Uri.RightChop(CommaIndex + 1), Buffers[BufferIndex]);
+					}
+				}
+				else
+				{
+					LoadFileCapped(BaseDirectory / FGenericPlatformHttp::UrlDecode(Uri), Buffers[BufferIndex]);
+				}
+			}
+
+			return Buffers[BufferIndex].Num() > 0 ? &Buffers[BufferIndex] : nullptr;
+		}
+	};
+
+	/** Accessor data resolved to a pointer, element count and stride */
+	struct FGltfAccessorView
+	{
+		const uint8* Data = nullptr;
+		int32 Count = 0;
+		int32 Stride = 0;
+		int32 ComponentType = 0;
+	};
+
+	static int32 GetComponentSize(int32 ComponentType)
+	{
+		switch (ComponentType)
+		{
+		case 5120: case 5121: return 1;
+		case 5122: case 5123: return 2;
+		case 5125: case 5126: return 4;
+		default: return 0;
+		}
+	}
+
+	static int32 GetNumComponents(const FString& Type)
+	{
+		if (Type == TEXT("SCALAR")) return 1;
+		if (Type == TEXT("VEC2")) return 2;
+		if (Type == TEXT("VEC3")) return 3;
+		if (Type == TEXT("VEC4")) return 4;
+		return 0;
+	}
+
+	static bool ResolveAccessor(FGltfDocument& Document, int32 AccessorIndex, FGltfAccessorView& OutView)
+	{
+		TSharedPtr<FJsonObject> Accessor = Document.GetElement(TEXT("accessors"), AccessorIndex);
+		int32 BufferViewIndex = INDEX_NONE;
+		if (!Accessor.IsValid() || !Accessor->TryGetNumberField(TEXT("bufferView"), BufferViewIndex) || Accessor->HasField(TEXT("sparse")))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> BufferView = Document.GetElement(TEXT("bufferViews"), BufferViewIndex);
+		int32 BufferIndex = INDEX_NONE;
+		if (!BufferView.IsValid() || !BufferView->TryGetNumberField(TEXT("buffer"), BufferIndex))
+		{
+			return false;
+		}
+
+		const TArray<uint8>* Buffer = Document.GetBuffer(BufferIndex);
+		if (!Buffer)
+		{
+			return false;
+		}
+
+		const int32 ComponentType = Accessor->GetIntegerField(TEXT("componentType"));
+		const int32 ElementSize = GetComponentSize(ComponentType) * GetNumComponents(Accessor->GetStringField(TEXT("type")));
+		const int32 Count = Accessor->GetIntegerField(TEXT("count"));
+
+		int64 ViewOffset = 0;
+		int64 AccessorOffset = 0;
+		int32 Stride = 0;
+		BufferView->TryGetNumberField(TEXT("byteOffset"), ViewOffset);
+		BufferView->TryGetNumberField(TEXT("byteStride"), Stride);
+		Accessor->TryGetNumberField(TEXT("byteOffset"), AccessorOffset);
+		Stride = Stride > 0 ? Stride : ElementSize;
+
+		const int64 Start = ViewOffset + AccessorOffset;
+		if (ElementSize <= 0 || Count <= 0 || Start < 0 || Start + (int64)(Count - 1) * Stride + ElementSize > Buffer->Num())
+		{
+			return false;
+		}
+
+		OutView.Data = Buffer->GetData() + Start;
+		OutView.Count = Count;
+		OutView.Stride = Stride;
+		OutView.ComponentType = ComponentType;
+		return true;
+	}
+
+	static FMatrix44f GetNodeLocalMatrix(const TSharedPtr<FJsonObject>& Node)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+
+		// glTF matrices are column-major with column vectors, which is UE's row-major row-vector layout
+		if (Node->TryGetArrayField(TEXT("matrix"), Values) && Values->Num() == 16)
+		{
+			FMatrix44f Matrix;
+			for (int32 Index = 0; Index < 16; Index++)
+			{
+				Matrix.M[Index / 4][Index % 4] = (float)(*Values)[Index]->AsNumber();
+			}
+			return Matrix;
+		}
+
+		FVector3f Translation = FVector3f::ZeroVector;
+		FQuat4f Rotation = FQuat4f::Identity;
+		FVector3f Scale = FVector3f::OneVector;
+
+		if (Node->TryGetArrayField(TEXT("translation"), Values) && Values->Num() == 3)
+		{
+			Translation = FVector3f((float)(*Values)[0]->AsNumber(), (float)(*Values)[1]->AsNumber(), (float)(*Values)[2]->AsNumber());
+		}
+		if (Node->TryGetArrayField(TEXT("rotation"), Values) && Values->Num() == 4)
+		{
+			Rotation = FQuat4f((float)(*Values)[0]->AsNumber(), (float)(*Values)[1]->AsNumber(), (float)(*Values)[2]->AsNumber(), (float)(*Values)[3]->AsNumber());
+		}
+		if (Node->TryGetArrayField(TEXT("scale"), Values) && Values->Num() == 3)
+		{
+			Scale = FVector3f((float)(*Values)[0]->AsNumber(), (float)(*Values)[1]->AsNumber(), (float)(*Values)[2]->AsNumber());
+		}
+
+		return FTransform3f(Rotation, Translation, Scale).ToMatrixWithScale();
+	}
+
+	struct FGltfMeshInstance
+	{
+		int32 MeshIndex;
+		FMatrix44f Transform;
+	};
+
+	static void CollectMeshInstances(const FGltfDocument& Document, int32 NodeIndex, const FMatrix44f& ParentTransform, int32 Depth, TArray<FGltfMeshInstance>& OutInstances)
+	{
+		TSharedPtr<FJsonObject> Node = Document.GetElement(TEXT("nodes"), NodeIndex);
+		if (!Node.IsValid() || Depth > 64)
+		{
+			return;
+		}
+
+		const FMatrix44f Transform = GetNodeLocalMatrix(Node) * ParentTransform;
+
+		int32 MeshIndex = INDEX_NONE;
+		if (Node->TryGetNumberField(TEXT("mesh"), MeshIndex))
+		{
+			OutInstances.Add({ MeshIndex, Transform });
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Children = nullptr;
+		if (Node->TryGetArrayField(TEXT("children"), Children))
+		{
+			for (const TSharedPtr<FJsonValue>& Child : *Children)
+			{
+				CollectMeshInstances(Document, (int32)Child->AsNumber(), Transform, Depth + 1, OutInstances);
+			}
+		}
+	}
+
+	static uint32 ReadIndex(const FGltfAccessorView& View, int32 Element)
+	{
+		const uint8* Data = View.Data + (int64)Element * View.Stride;
+		switch (View.ComponentType)
+		{
+		case 5121: return *Data;
+		case 5123: return *(const uint16*)Data;
+		default: return *(const uint32*)Data;
+		}
+	}
+
+	static bool ParseGlb(const TArray<uint8>& FileData, FString& OutJson, TArray<uint8>& OutBinaryChunk)
+	{
+		// 12 byte header, then chunks of (length, type, data) padded to 4 bytes
+		const uint32* Header = (const uint32*)FileData.GetData();
+		if (FileData.Num() < 20 || Header[0] != 0x46546C67 || Header[1] != 2)
+		{
+			return false;
+		}
+
+		int64 Offset = 12;
+		while (Offset + 8 <= FileData.Num())
+		{
+			const uint32 ChunkLength = *(const uint32*)(FileData.GetData() + Offset);
+			const uint32 ChunkType = *(const uint32*)(FileData.GetData() + Offset + 4);
+			const uint8* ChunkData = FileData.GetData() + Offset + 8;
+			if (Offset + 8 + ChunkLength > (uint64)FileData.Num())
+			{
+				return false;
+			}
+
+			if (ChunkType == 0x4E4F534A)
+			{
+				FUTF8ToTCHAR Converter((const ANSICHAR*)ChunkData, ChunkLength);
+				OutJson = FString(Converter.Length(), Converter.Get());
+			}
+			else if (ChunkType == 0x004E4942)
+			{
+				OutBinaryChunk.Append(ChunkData, ChunkLength);
+			}
+
+			Offset += 8 + Align(ChunkLength, 4);
+		}
+
+		return !OutJson.IsEmpty();
+	}
+
+	bool LoadGltf(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh)
+	{
+		TArray<uint8> FileData;
+		if (!LoadFileCapped(FilePath, FileData))
+		{
+			return false;
+		}
+
+		FGltfDocument Document;
+		Document.BaseDirectory = FPaths::GetPath(FilePath);
+
+		FString Json;
+		if (FPaths::GetExtension(FilePath).ToLower() == TEXT("glb"))
+		{
+			if (!ParseGlb(FileData, Json, Document.BinaryChunk))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			FFileHelper::BufferToString(Json, FileData.GetData(), FileData.Num());
+		}
+		FileData.Empty();
+
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(Reader, Document.Root) || !Document.Root.IsValid())
+		{
+			return false;
+		}
+
+		// Walk the default scene; files without scenes just list their meshes untransformed
+		TArray<FGltfMeshInstance> Instances;
+		int32 SceneIndex = 0;
+		Document.Root->TryGetNumberField(TEXT("scene"), SceneIndex);
+
+		const TArray<TSharedPtr<FJsonValue>>* SceneNodes = nullptr;
+		TSharedPtr<FJsonObject> Scene = Document.GetElement(TEXT("scenes"), SceneIndex);
+		if (Scene.IsValid() && Scene->TryGetArrayField(TEXT("nodes"), SceneNodes))
+		{
+			for (const TSharedPtr<FJsonValue>& NodeValue : *SceneNodes)
+			{
+				CollectMeshInstances(Document, (int32)NodeValue->AsNumber(), FMatrix44f::Identity, 0, Instances);
+			}
+		}
+		else if (const TArray<TSharedPtr<FJsonValue>>* Meshes = Document.GetArray(TEXT("meshes")))
+		{
+			for (int32 MeshIndex = 0; MeshIndex < Meshes->Num(); MeshIndex++)
+			{
+				Instances.Add({ MeshIndex, FMatrix44f::Identity });
+			}
+		}
+
+		// Triangle primitives as (position accessor, index accessor or none, transform)
+		struct FPrimitive
+		{
+			int32 PositionAccessor;
+			int32 IndexAccessor;
+			const FMatrix44f* Transform;
+		};
+		TArray<FPrimitive> Primitives;
+		int64 TotalTriangles = 0;
+
+		for (const FGltfMeshInstance& Instance : Instances)
+		{
+			TSharedPtr<FJsonObject> Mesh = Document.GetElement(TEXT("meshes"), Instance.MeshIndex);
+			const TArray<TSharedPtr<FJsonValue>>* MeshPrimitives = nullptr;
+			if (!Mesh.IsValid() || !Mesh->TryGetArrayField(TEXT("primitives"), MeshPrimitives))
+			{
+				continue;
+			}
+
+			for (const TSharedPtr<FJsonValue>& PrimitiveValue : *MeshPrimitives)
+			{
+				TSharedPtr<FJsonObject> Primitive = PrimitiveValue->AsObject();
+				const TSharedPtr<FJsonObject>* Attributes = nullptr;
+				int32 Mode = 4;
+				Primitive->TryGetNumberField(TEXT("mode"), Mode);
+
+				// Only plain triangle lists; Draco compressed primitives have no readable accessors
+				if (Mode != 4 || !Primitive->TryGetObjectField(TEXT("attributes"), Attributes) || Primitive->HasField(TEXT("extensions")))
+				{
+					continue;
+				}
+
+				int32 PositionAccessor = INDEX_NONE;
+				if (!(*Attributes)->TryGetNumberField(TEXT("POSITION"), PositionAccessor))
+				{
+					continue;
+				}
+
+				int32 IndexAccessor = INDEX_NONE;
+				Primitive->TryGetNumberField(TEXT("indices"), IndexAccessor);
+
+				TSharedPtr<FJsonObject> CountAccessor = Document.GetElement(TEXT("accessors"), IndexAccessor != INDEX_NONE ? IndexAccessor : PositionAccessor);
+				TotalTriangles += CountAccessor.IsValid() ? CountAccessor->GetIntegerField(TEXT("count")) / 3 : 0;
+
+				Primitives.Add({ PositionAccessor, IndexAccessor, &Instance.Transform });
+			}
+		}
+
+		const int32 TriangleStride = GetTriangleStride(TotalTriangles, MaxTriangles);
+		int64 TriangleCounter = 0;
+
+		for (const FPrimitive& Primitive : Primitives)
+		{
+			FGltfAccessorView Positions;
+			if (!ResolveAccessor(Document, Primitive.PositionAccessor, Positions) || Positions.ComponentType != 5126)
+			{
+				continue;
+			}
+
+			FGltfAccessorView Indices;
+			const bool bIndexed = Primitive.IndexAccessor != INDEX_NONE;
+			if (bIndexed && !ResolveAccessor(Document, Primitive.IndexAccessor, Indices))
+			{
+				continue;
+			}
+
+			const uint32 BaseVertex = OutMesh.Positions.Num();
+			OutMesh.Positions.Reserve(BaseVertex + Positions.Count);
+			for (int32 Vertex = 0; Vertex < Positions.Count; Vertex++)
+			{
+				const float* Position = (const float*)(Positions.Data + (int64)Vertex * Positions.Stride);
+				OutMesh.Positions.Add(Primitive.Transform->TransformPosition(FVector3f(Position[0], Position[1], Position[2])));
+			}
+
+			const int32 NumCorners = bIndexed ? Indices.Count : Positions.Count;
+			for (int32 Corner = 0; Corner + 2 < NumCorners; Corner += 3)
+			{
+				if (TriangleCounter++ % TriangleStride != 0)
+				{
+					continue;
+				}
+
+				for (int32 Offset = 0; Offset < 3; Offset++)
+				{
+					const uint32 Index = bIndexed ? ReadIndex(Indices, Corner + Offset) : Corner + Offset;
+					OutMesh.Indices.Add(Index < (uint32)Positions.Count ? BaseVertex + Index : BaseVertex);
+				}
+			}
+		}
+
+		return OutMesh.Indices.Num() > 0;
+	}
+}
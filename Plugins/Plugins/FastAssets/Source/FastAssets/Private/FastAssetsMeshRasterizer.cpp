@@ -0,0 +1,212 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsMeshRasterizer.h"
+#include "FastAssetsMeshLoader.h"
+#include "FastAssetsImageProcessing.h"
+
+namespace FastAssetsMeshRasterizer
+{
+	typedef TArray<float, TAlignedHeapAllocator<16>> FAlignedFloatArray;
+
+	/** Rendered at this multiple of the thumbnail size, then area filtered down for anti-aliasing */
+	static constexpr int32 Supersample = 2;
+
+	/** Camera angles: a three-quarter view from slightly above */
+	static constexpr float CameraYawDegrees = 35.0f;
+	static constexpr float CameraPitchDegrees = 25.0f;
+
+	/** Vertex after the view transform: X/Y in pixels, Z grows towards the camera */
+	struct FScreenVertex
+	{
+		float X;
+		float Y;
+		float Z;
+		float Pad;
+	};
+
+	/** Transform every vertex into screen space with the view rotation and framing folded into one matrix */
+	static void TransformVertices(const FFastAssetsMeshData& Mesh, const FVector3f& Center, float Scale, int32 RenderSize, TArray<FScreenVertex, TAlignedHeapAllocator<16>>& OutVertices)
+	{
+		float SinYaw, CosYaw, SinPitch, CosPitch;
+		FMath::SinCos(&SinYaw, &CosYaw, FMath::DegreesToRadians(CameraYawDegrees));
+		FMath::SinCos(&SinPitch, &CosPitch, FMath::DegreesToRadians(CameraPitchDegrees));
+
+		// Yaw around Y, then pitch around X; columns are where each source axis lands in view space.
+		// Screen Y points down, so the view Y row is negated.
+		const float HalfSize = RenderSize * 0.5f;
+		const VectorRegister4Float AxisX = MakeVectorRegisterFloat(CosYaw * Scale, SinPitch * SinYaw * Scale, -CosPitch * SinYaw * Scale, 0.0f);
+		const VectorRegister4Float AxisY = MakeVectorRegisterFloat(0.0f, -CosPitch * Scale, SinPitch * Scale, 0.0f);
+		const VectorRegister4Float AxisZ = MakeVectorRegisterFloat(SinYaw * Scale, -SinPitch * CosYaw * Scale, CosPitch * CosYaw * Scale, 0.0f);
+		const VectorRegister4Float Offset = MakeVectorRegisterFloat(HalfSize, HalfSize, 0.0f, 0.0f);
+
+		OutVertices.SetNumUninitialized(Mesh.Positions.Num());
+		for (int32 Index = 0; Index < Mesh.Positions.Num(); Index++)
+		{
+			const FVector3f Local = Mesh.Positions[Index] - Center;
+
+			VectorRegister4Float Result = VectorMultiplyAdd(VectorSetFloat1(Local.X), AxisX, Offset);
+			Result = VectorMultiplyAdd(VectorSetFloat1(Local.Y), AxisY, Result);
+			Result = VectorMultiplyAdd(VectorSetFloat1(Local.Z), AxisZ, Result);
+			VectorStoreAligned(Result, &OutVertices[Index].X);
+		}
+	}
+
+	/** Lambert from a light over the camera's shoulder, lit from both sides since many meshes are not closed */
+	static uint32 ShadeTriangle(const FScreenVertex& A, const FScreenVertex& B, const FScreenVertex& C)
+	{
+		const FVector3f Edge1(B.X - A.X, B.Y - A.Y, B.Z - A.Z);
+		const FVector3f Edge2(C.X - A.X, C.Y - A.Y, C.Z - A.Z);
+		const FVector3f Normal = FVector3f::CrossProduct(Edge1, Edge2).GetSafeNormal();
+
+		static const FVector3f LightDirection = FVector3f(-0.35f, -0.6f, 0.72f).GetSafeNormal();
+		const float Diffuse = FMath::Abs(FVector3f::DotProduct(Normal, LightDirection));
+		const float Light = 0.22f + 0.78f * Diffuse;
+
+		const uint8 Red = (uint8)FMath::Clamp(FMath::RoundToInt(0.78f * Light * 255.0f), 0, 255);
+		const uint8 Green = (uint8)FMath::Clamp(FMath::RoundToInt(0.76f * Light * 255.0f), 0, 255);
+		const uint8 Blue = (uint8)FMath::Clamp(FMath::RoundToInt(0.72f * Light * 255.0f), 0, 255);
+
+		// BGRA8 in memory
+		return (uint32)Blue | ((uint32)Green << 8) | ((uint32)Red << 16) | (0xFFu << 24);
+	}
+
+	/** Rasterize one triangle with edge functions, four pixels at a time */
+	static void RasterizeTriangle(FScreenVertex V0, FScreenVertex V1, FScreenVertex V2, uint32 Color, int32 RenderSize, float* DepthBuffer, uint32* ColorBuffer)
+	{
+		float Area = (V1.X - V0.X) * (V2.Y - V0.Y) - (V1.Y - V0.Y) * (V2.X - V0.X);
+		if (FMath::Abs(Area) < 1e-6f)
+		{
+			return;
+		}
+
+		// Double sided: flip the winding instead of culling
+		if (Area < 0.0f)
+		{
+			Swap(V1, V2);
+			Area = -Area;
+		}
+
+		const int32 MinX = FMath::Max(FMath::FloorToInt(FMath::Min3(V0.X, V1.X, V2.X)), 0) & ~3;
+		const int32 MaxX = FMath::Min(FMath::CeilToInt(FMath::Max3(V0.X, V1.X, V2.X)), RenderSize - 1);
+		const int32 MinY = FMath::Max(FMath::FloorToInt(FMath::Min3(V0.Y, V1.Y, V2.Y)), 0);
+		const int32 MaxY = FMath::Min(FMath::CeilToInt(FMath::Max3(V0.Y, V1.Y, V2.Y)), RenderSize - 1);
+		if (MinX > MaxX || MinY > MaxY)
+		{
+			return;
+		}
+
+		// Edge function E(x, y) = A * x + B * y + C, positive inside; evaluated at pixel centers
+		auto SetupEdge = [](const FScreenVertex& From, const FScreenVertex& To, float& OutA, float& OutB, float& OutC)
+		{
+			OutA = From.Y - To.Y;
+			OutB = To.X - From.X;
+			OutC = From.X * To.Y - From.Y * To.X;
+		};
+
+		float A0, B0, C0, A1, B1, C1, A2, B2, C2;
+		SetupEdge(V1, V2, A0, B0, C0);
+		SetupEdge(V2, V0, A1, B1, C1);
+		SetupEdge(V0, V1, A2, B2, C2);
+
+		// Depth as a plane over the barycentric weights, divided by area up front
+		const float InvArea = 1.0f / Area;
+		const VectorRegister4Float Z0 = VectorSetFloat1(V0.Z * InvArea);
+		const VectorRegister4Float Z1 = VectorSetFloat1(V1.Z * InvArea);
+		const VectorRegister4Float Z2 = VectorSetFloat1(V2.Z * InvArea);
+
+		const VectorRegister4Float Lane = MakeVectorRegisterFloat(0.0f, 1.0f, 2.0f, 3.0f);
+		const VectorRegister4Float StepX0 = VectorMultiply(VectorSetFloat1(A0), Lane);
+		const VectorRegister4Float StepX1 = VectorMultiply(VectorSetFloat1(A1), Lane);
+		const VectorRegister4Float StepX2 = VectorMultiply(VectorSetFloat1(A2), Lane);
+		const VectorRegister4Float Step4X0 = VectorSetFloat1(A0 * 4.0f);
+		const VectorRegister4Float Step4X1 = VectorSetFloat1(A1 * 4.0f);
+		const VectorRegister4Float Step4X2 = VectorSetFloat1(A2 * 4.0f);
+		const VectorRegister4Float Zero = VectorZeroFloat();
+
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			const float PixelY = Y + 0.5f;
+			const float PixelX = MinX + 0.5f;
+
+			VectorRegister4Float W0 = VectorAdd(VectorSetFloat1(A0 * PixelX + B0 * PixelY + C0), StepX0);
+			VectorRegister4Float W1 = VectorAdd(VectorSetFloat1(A1 * PixelX + B1 * PixelY + C1), StepX1);
+			VectorRegister4Float W2 = VectorAdd(VectorSetFloat1(A2 * PixelX + B2 * PixelY + C2), StepX2);
+
+			float* DepthRow = DepthBuffer + (int64)Y * RenderSize;
+			uint32* ColorRow = ColorBuffer + (int64)Y * RenderSize;
+
+			for (int32 X = MinX; X <= MaxX; X += 4)
+			{
+				VectorRegister4Float Inside = VectorBitwiseAnd(VectorCompareGE(W0, Zero), VectorBitwiseAnd(VectorCompareGE(W1, Zero), VectorCompareGE(W2, Zero)));
+
+				if (VectorMaskBits(Inside))
+				{
+					const VectorRegister4Float Depth = VectorMultiplyAdd(W0, Z0, VectorMultiplyAdd(W1, Z1, VectorMultiply(W2, Z2)));
+					const VectorRegister4Float OldDepth = VectorLoadAligned(DepthRow + X);
+					const VectorRegister4Float Visible = VectorBitwiseAnd(Inside, VectorCompareGT(Depth, OldDepth));
+
+					const uint32 VisibleBits = VectorMaskBits(Visible);
+					if (VisibleBits)
+					{
+						VectorStoreAligned(VectorSelect(Visible, Depth, OldDepth), DepthRow + X);
+						for (int32 LaneIndex = 0; LaneIndex < 4; LaneIndex++)
+						{
+							if (VisibleBits & (1u << LaneIndex))
+							{
+								ColorRow[X + LaneIndex] = Color;
+							}
+						}
+					}
+				}
+
+				W0 = VectorAdd(W0, Step4X0);
+				W1 = VectorAdd(W1, Step4X1);
+				W2 = VectorAdd(W2, Step4X2);
+			}
+		}
+	}
+
+	bool RenderThumbnail(const FFastAssetsMeshData& Mesh, int32 Size, TArray<uint8>& OutPixels)
+	{
+		if (Size <= 0 || Mesh.NumTriangles() == 0)
+		{
+			return false;
+		}
+
+		const FBox3f Bounds(Mesh.Positions.GetData(), Mesh.Positions.Num());
+		const float Radius = Bounds.GetExtent().Size();
+		if (!Bounds.IsValid || Radius <= UE_SMALL_NUMBER || !FMath::IsFinite(Radius))
+		{
+			return false;
+		}
+
+		// Rows are processed in groups of four pixels, so keep the width a multiple of four
+		const int32 RenderSize = Align(Size * Supersample, 4);
+		const float Scale = RenderSize * 0.5f * 0.92f / Radius;
+
+		TArray<FScreenVertex, TAlignedHeapAllocator<16>> Vertices;
+		TransformVertices(Mesh, Bounds.GetCenter(), Scale, RenderSize, Vertices);
+
+		FAlignedFloatArray DepthBuffer;
+		DepthBuffer.Init(-UE_BIG_NUMBER, RenderSize * RenderSize);
+
+		// Transparent background, so the tile color shows around the mesh
+		TArray<uint8> Rendered;
+		Rendered.SetNumZeroed(RenderSize * RenderSize * 4);
+		uint32* ColorBuffer = (uint32*)Rendered.GetData();
+
+		const int32 NumTriangles = Mesh.NumTriangles();
+		for (int32 Triangle = 0; Triangle < NumTriangles; Triangle++)
+		{
+			const FScreenVertex& V0 = Vertices[Mesh.Indices[Triangle * 3 + 0]];
+			const FScreenVertex& V1 = Vertices[Mesh.Indices[Triangle * 3 + 1]];
+			const FScreenVertex& V2 = Vertices[Mesh.Indices[Triangle * 3 + 2]];
+
+			RasterizeTriangle(V0, V1, V2, ShadeTriangle(V0, V1, V2), RenderSize, DepthBuffer.GetData(), ColorBuffer);
+		}
+
+		OutPixels.SetNumUninitialized(Size * Size * 4);
+		FastAssetsImageProcessing::DownscaleBGRA8(Rendered.GetData(), RenderSize, RenderSize, OutPixels.GetData(), Size, Size);
+		return true;
+	}
+}
@@ -35,6 +35,18 @@ UFastAssetsSettings::UFastAssetsSettings()
 	// Scanning defaults
 	bRecursiveScan = true;
 	MaxScanDepth = 0; // Unlimited
+
+	// Performance defaults
+	ThumbnailCacheBudgetMB = 256;
+	bEnableDiskThumbnailCache = true;
+	DiskThumbnailCacheMaxMB = 2048;
+	bDecodeThumbnailsOutOfProcess = false;
+	ThumbnailHelperProcesses = 2;
+	MainThreadBudgetMs = 2.0f;
+	bDenseGridView = false;
+	bKeepCatalogOnDisk = false;
+	bWarmUpRecentPaths = false;
+	WarmUpRecentPathsCount = 3;
 }
 
 UFastAssetsSettings* UFastAssetsSettings::Get()
@@ -57,6 +69,21 @@ int32 UFastAssetsSettings::GetThumbnailSizePixels() const
 	}
 }
 
+double UFastAssetsSettings::GetMainThreadBudgetSeconds() const
+{
+	return FMath::Max(MainThreadBudgetMs, 0.5f) / 1000.0;
+}
+
+int64 UFastAssetsSettings::GetThumbnailCacheBudgetBytes() const
+{
+	return (int64)FMath::Max(ThumbnailCacheBudgetMB, 16) * 1024 * 1024;
+}
+
+int64 UFastAssetsSettings::GetDiskThumbnailCacheBudgetBytes() const
+{
+	return (int64)FMath::Max(DiskThumbnailCacheMaxMB, 64) * 1024 * 1024;
+}
+
 void UFastAssetsSettings::AddRecentPath(const FString& Path)
 {
 	if (Path.IsEmpty())
@@ -132,6 +159,18 @@ void UFastAssetsSettings::ResetToDefaults()
 	IncludeExtensions.Empty();
 	ExcludeExtensions.Empty();
 
+	// Performance
+	ThumbnailCacheBudgetMB = 256;
+	bEnableDiskThumbnailCache = true;
+	DiskThumbnailCacheMaxMB = 2048;
+	bDecodeThumbnailsOutOfProcess = false;
+	ThumbnailHelperProcesses = 2;
+	MainThreadBudgetMs = 2.0f;
+	bDenseGridView = false;
+	bKeepCatalogOnDisk = false;
+	bWarmUpRecentPaths = false;
+	WarmUpRecentPathsCount = 3;
+
 	SaveConfig();
 }
 
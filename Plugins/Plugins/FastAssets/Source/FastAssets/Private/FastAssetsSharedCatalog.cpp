@@ -0,0 +1,482 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsSharedCatalog.h"
+#include "FastAssetsCatalog.h"
+#include "FastAssetsSettings.h"
+#include "FastAssetsStats.h"
+#include "FastAssetsUpdateApplier.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Catalog Items Built"), STAT_FastAssetsCatalogItemsBuilt, STATGROUP_FastAssets);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Shared Catalogs"), STAT_FastAssetsSharedCatalogs, STATGROUP_FastAssets);
+
+TMap<FString, TWeakPtr<FFastAssetsSharedCatalog>> FFastAssetsSharedCatalog::Catalogs;
+
+TSharedRef<FFastAssetsSharedCatalog> FFastAssetsSharedCatalog::Get(const FString& RootPath)
+{
+	check(IsInGameThread());
+
+	// Different spellings of the same folder share a catalog; keys compare ignoring case
+	FString Key = FPaths::ConvertRelativePathToFull(RootPath);
+	FPaths::NormalizeDirectoryName(Key);
+
+	if (TSharedPtr<FFastAssetsSharedCatalog> Existing = Catalogs.FindRef(Key).Pin())
+	{
+		return Existing.ToSharedRef();
+	}
+
+	// Forget catalogs no window holds any more
+	for (auto It = Catalogs.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TSharedRef<FFastAssetsSharedCatalog> Catalog = MakeShareable(new FFastAssetsSharedCatalog(RootPath));
+	Catalogs.Add(Key, Catalog);
+	return Catalog;
+}
+
+FFastAssetsSharedCatalog::FFastAssetsSharedCatalog(const FString& InRootPath)
+	: RootPath(InRootPath)
+{
+	FolderTree.Reset(RootPath);
+	INC_DWORD_STAT(STAT_FastAssetsSharedCatalogs);
+}
+
+FFastAssetsSharedCatalog::~FFastAssetsSharedCatalog()
+{
+	if (ScanCancelFlag.IsValid())
+	{
+		*ScanCancelFlag = true;
+	}
+	DEC_DWORD_STAT(STAT_FastAssetsSharedCatalogs);
+}
+
+void FFastAssetsSharedCatalog::EnsureScanned()
+{
+	if (!bScanStarted)
+	{
+		StartScan();
+	}
+}
+
+void FFastAssetsSharedCatalog::Rescan()
+{
+	StartScan();
+}
+
+void FFastAssetsSharedCatalog::StartScan()
+{
+	bScanStarted = true;
+
+	// Results still coming from the previous scan are dropped
+	if (ScanCancelFlag.IsValid())
+	{
+		*ScanCancelFlag = true;
+	}
+	FFastAssetsCancelFlag CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	ScanCancelFlag = CancelFlag;
+
+	const bool bToDisk = UFastAssetsSettings::Get()->bKeepCatalogOnDisk;
+
+	// A rescan keeps the current assets on screen and swaps in the differences at the end;
+	// a first scan streams in as it goes
+	bRescanning = !bToDisk && !DiskCatalog.IsValid() && Assets.Num() > 0;
+	RescannedAssets.Reset();
+
+	bool bCleared = false;
+	if (!bRescanning)
+	{
+		bCleared = Assets.Num() > 0;
+		Assets.Empty();
+
+		// A catalog on disk stays on screen until the rescan has written the new one
+		if (!bToDisk && DiskCatalog.IsValid())
+		{
+			DiskCatalog.Reset();
+			DiskItems.Empty();
+			RecentDiskItems.Empty();
+			FolderTree.Reset(RootPath);
+			bCleared = true;
+		}
+	}
+
+	bScanning = true;
+	bScanningToDisk = bToDisk;
+	DiskScanProgress = 0;
+	OnChangedDelegate.Broadcast(bCleared ? INDEX_NONE : Assets.Num());
+
+	// Created here on the game thread, and held by the worker so its queue outlives a shutdown mid-scan
+	TSharedRef<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> Applier = FFastAssetsUpdateApplier::GetShared();
+	TWeakPtr<FFastAssetsSharedCatalog> WeakCatalog = AsShared();
+	const FString Path = RootPath;
+
+	if (bToDisk)
+	{
+		Async(EAsyncExecution::ThreadPool, [Path, CancelFlag, WeakCatalog, Applier]()
+		{
+			// Records go straight to disk; only the folders are kept in memory
+			FFastAssetsCatalog::FWriter Writer(Path);
+			TSharedRef<FFastAssetsFolderTree> ScannedFolders = MakeShared<FFastAssetsFolderTree>();
+			ScannedFolders->Reset(Path);
+
+			// The stat visitor gets size and time with each file, so no file is opened or stat'ed twice
+			FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*Path, [&](const TCHAR* FilePath, const FFileStatData& StatData)
+			{
+				if (*CancelFlag)
+				{
+					return false;
+				}
+
+				const int32 TypeIndex = StatData.bIsDirectory ? INDEX_NONE : GetSupportedExtensionIndex(FPaths::GetExtension(FilePath).ToLower());
+				if (TypeIndex != INDEX_NONE)
+				{
+					Writer.AddFile(FilePath, StatData.FileSize, StatData.ModificationTime, (uint8)TypeIndex);
+					ScannedFolders->AddFile(FilePath, StatData.FileSize);
+
+					if (Writer.Num() % DiskProgressInterval == 0)
+					{
+						Applier->EnqueueUpdate([NumFiles = Writer.Num(), CancelFlag, WeakCatalog]()
+						{
+							TSharedPtr<FFastAssetsSharedCatalog> Catalog = WeakCatalog.Pin();
+							if (Catalog.IsValid() && !*CancelFlag)
+							{
+								Catalog->DiskScanProgress = NumFiles;
+								Catalog->OnChangedDelegate.Broadcast(Catalog->Assets.Num());
+							}
+						});
+					}
+				}
+				return true;
+			});
+
+			if (*CancelFlag)
+			{
+				return;
+			}
+
+			TSharedPtr<FFastAssetsCatalog> ScannedCatalog = Writer.Finish();
+			Applier->EnqueueUpdate([ScannedCatalog, ScannedFolders, CancelFlag, WeakCatalog]()
+			{
+				TSharedPtr<FFastAssetsSharedCatalog> Catalog = WeakCatalog.Pin();
+				if (Catalog.IsValid() && !*CancelFlag)
+				{
+					Catalog->OnDiskScanned(ScannedCatalog, MoveTemp(*ScannedFolders));
+				}
+			});
+		});
+		return;
+	}
+
+	Async(EAsyncExecution::ThreadPool, [Path, CancelFlag, WeakCatalog, Applier]()
+	{
+		// Find all files recursively
+		TArray<FString> FoundFiles;
+		IFileManager::Get().FindFilesRecursive(FoundFiles, *Path, TEXT("*.*"), true, false);
+
+		// Items are built here and handed over in batches, so the game thread only appends them
+		TArray<TSharedPtr<FExternalAssetItem>> Batch;
+		auto SendBatch = [&Batch, &Applier, CancelFlag, WeakCatalog](bool bScanFinished)
+		{
+			Applier->EnqueueUpdate([Items = MoveTemp(Batch), CancelFlag, WeakCatalog, bScanFinished]() mutable
+			{
+				TSharedPtr<FFastAssetsSharedCatalog> Catalog = WeakCatalog.Pin();
+				if (Catalog.IsValid() && !*CancelFlag)
+				{
+					Catalog->AddScannedAssets(MoveTemp(Items), bScanFinished);
+				}
+			});
+			Batch.Reset();
+		};
+
+		for (const FString& FilePath : FoundFiles)
+		{
+			if (*CancelFlag)
+			{
+				return;
+			}
+
+			FString Extension = FPaths::GetExtension(FilePath).ToLower();
+			if (GetSupportedExtensionIndex(Extension) != INDEX_NONE)
+			{
+				Batch.Add(MakeAssetItem(FilePath, Extension));
+				if (Batch.Num() >= ScanBatchSize)
+				{
+					SendBatch(false);
+				}
+			}
+		}
+
+		SendBatch(true);
+	});
+}
+
+void FFastAssetsSharedCatalog::AddScannedAssets(TArray<TSharedPtr<FExternalAssetItem>>&& Items, bool bScanFinished)
+{
+	if (bRescanning)
+	{
+		RescannedAssets.Append(MoveTemp(Items));
+		if (bScanFinished)
+		{
+			ApplyRescan();
+		}
+		return;
+	}
+
+	// Appending keeps every index the windows show valid, so their widgets, selection and scroll position are untouched
+	const int32 FirstAddedIndex = Assets.Num();
+	for (TSharedPtr<FExternalAssetItem>& Item : Items)
+	{
+		Item->SortIndex = Assets.Num();
+		FolderTree.AddFile(Item->FilePath, Item->FileSize);
+		Assets.Add(MoveTemp(Item));
+	}
+
+	bScanning = !bScanFinished;
+	OnChangedDelegate.Broadcast(FirstAddedIndex);
+}
+
+void FFastAssetsSharedCatalog::ApplyRescan()
+{
+	// Keep the existing item of every file that did not change, so its row widgets, thumbnail and selection survive
+	TMap<FString, TSharedPtr<FExternalAssetItem>> ExistingItems;
+	ExistingItems.Reserve(Assets.Num());
+	for (const TSharedPtr<FExternalAssetItem>& Item : Assets)
+	{
+		ExistingItems.Add(Item->FilePath, Item);
+	}
+
+	for (int32 Index = 0; Index < RescannedAssets.Num(); Index++)
+	{
+		TSharedPtr<FExternalAssetItem>& Item = RescannedAssets[Index];
+		const TSharedPtr<FExternalAssetItem>* Existing = ExistingItems.Find(Item->FilePath);
+		if (Existing && (*Existing)->FileSize == Item->FileSize && (*Existing)->ModifiedTime == Item->ModifiedTime)
+		{
+			Item = *Existing;
+			ExistingItems.Remove(Item->FilePath);
+		}
+		else
+		{
+			FolderTree.AddFile(Item->FilePath, Item->FileSize);
+		}
+		Item->SortIndex = Index;
+	}
+
+	// Whatever was not reused was deleted or changed; only those are taken out of the folder totals
+	for (const TPair<FString, TSharedPtr<FExternalAssetItem>>& Removed : ExistingItems)
+	{
+		FolderTree.RemoveFile(Removed.Value->FilePath, Removed.Value->FileSize);
+	}
+
+	Assets = MoveTemp(RescannedAssets);
+	RescannedAssets.Reset();
+	bRescanning = false;
+	bScanning = false;
+
+	OnChangedDelegate.Broadcast(INDEX_NONE);
+}
+
+void FFastAssetsSharedCatalog::OnDiskScanned(const TSharedPtr<FFastAssetsCatalog>& Catalog, FFastAssetsFolderTree&& ScannedFolders)
+{
+	bScanning = false;
+	bScanningToDisk = false;
+
+	DiskCatalog = Catalog;
+	DiskItems.Empty();
+	RecentDiskItems.Empty();
+	NextRecentDiskItem = 0;
+
+	// The folders were counted on the scan worker
+	if (Catalog.IsValid())
+	{
+		FolderTree = MoveTemp(ScannedFolders);
+	}
+
+	OnChangedDelegate.Broadcast(INDEX_NONE);
+}
+
+TSharedPtr<FExternalAssetItem> FFastAssetsSharedCatalog::GetDiskItem(const TSharedRef<FFastAssetsCatalog>& FromCatalog, int32 RecordIndex)
+{
+	// A window still showing the previous catalog after a rescan gets items that are not shared
+	const bool bShared = FromCatalog == DiskCatalog;
+	if (const TWeakPtr<FExternalAssetItem>* DiskItem = bShared ? DiskItems.Find(RecordIndex) : nullptr)
+	{
+		if (TSharedPtr<FExternalAssetItem> Item = DiskItem->Pin())
+		{
+			return Item;
+		}
+	}
+
+	const FFastAssetsCatalog::FRecord& Record = FromCatalog->GetRecord(RecordIndex);
+	TSharedPtr<FExternalAssetItem> Item = MakeAssetItem(FString(FromCatalog->GetPath(Record)),
+		GetSupportedExtensions()[Record.TypeIndex], Record.FileSize, FDateTime(Record.ModifiedTicks));
+	Item->SortIndex = RecordIndex;
+	INC_DWORD_STAT(STAT_FastAssetsCatalogItemsBuilt);
+
+	if (!bShared)
+	{
+		return Item;
+	}
+
+	// Forget items nobody holds any more, before the map grows past what can be alive
+	if (DiskItems.Num() >= PruneDiskItemsAt)
+	{
+		for (auto It = DiskItems.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		PruneDiskItemsAt = FMath::Max(MaxRecentDiskItems * 2, DiskItems.Num() * 2);
+	}
+
+	if (RecentDiskItems.Num() < MaxRecentDiskItems)
+	{
+		RecentDiskItems.SetNum(MaxRecentDiskItems);
+	}
+
+	DiskItems.Add(RecordIndex, Item);
+	RecentDiskItems[NextRecentDiskItem] = Item;
+	NextRecentDiskItem = (NextRecentDiskItem + 1) % MaxRecentDiskItems;
+	return Item;
+}
+
+bool FFastAssetsSharedCatalog::IsDiskItem(const FExternalAssetItem& Item) const
+{
+	// SortIndex is the record index, but only for items built from this catalog
+	const TWeakPtr<FExternalAssetItem>* DiskItem = DiskItems.Find(Item.SortIndex);
+	return DiskItem && DiskItem->HasSameObject(&Item);
+}
+
+const TArray<FString>& FFastAssetsSharedCatalog::GetSupportedExtensions()
+{
+	// Catalog records store an index into this list, so new extensions go at the end
+	static const TArray<FString> SupportedExtensions = {
+		// 3D Models
+		TEXT("fbx"), TEXT("obj"), TEXT("gltf"), TEXT("glb"), TEXT("usd"), TEXT("usda"), TEXT("usdc"), TEXT("abc"),
+		// Audio
+		TEXT("wav"), TEXT("mp3"), TEXT("ogg"), TEXT("flac"), TEXT("aiff"),
+		// Images/Textures
+		TEXT("png"), TEXT("jpg"), TEXT("jpeg"), TEXT("tga"), TEXT("bmp"), TEXT("exr"), TEXT("hdr"), TEXT("psd"), TEXT("tiff"),
+		// Unreal
+		TEXT("uasset"), TEXT("umap"),
+		// Data
+		TEXT("json"), TEXT("csv")
+	};
+	return SupportedExtensions;
+}
+
+int32 FFastAssetsSharedCatalog::GetSupportedExtensionIndex(const FString& Extension)
+{
+	static const TMap<FString, int32> ExtensionIndices = []()
+	{
+		TMap<FString, int32> Indices;
+		for (int32 Index = 0; Index < GetSupportedExtensions().Num(); Index++)
+		{
+			Indices.Add(GetSupportedExtensions()[Index], Index);
+		}
+		return Indices;
+	}();
+
+	const int32* Index = ExtensionIndices.Find(Extension);
+	return Index ? *Index : INDEX_NONE;
+}
+
+TSharedPtr<FExternalAssetItem> FFastAssetsSharedCatalog::MakeAssetItem(const FString& FilePath, const FString& Extension)
+{
+	return MakeAssetItem(FilePath, Extension, IFileManager::Get().FileSize(*FilePath), IFileManager::Get().GetTimeStamp(*FilePath));
+}
+
+TSharedPtr<FExternalAssetItem> FFastAssetsSharedCatalog::MakeAssetItem(const FString& FilePath, const FString& Extension, int64 FileSize, const FDateTime& ModifiedTime)
+{
+	TSharedPtr<FExternalAssetItem> NewItem = MakeShared<FExternalAssetItem>();
+	NewItem->FilePath = FilePath;
+	NewItem->FileName = FPaths::GetBaseFilename(FilePath);
+	NewItem->Extension = Extension;
+	NewItem->AssetType = DetermineAssetType(Extension);
+	NewItem->FileSize = FileSize;
+	NewItem->ModifiedTime = ModifiedTime;
+	NewItem->NameText = FText::FromString(NewItem->FileName);
+	NewItem->TypeText = FText::FromString(NewItem->AssetType);
+	NewItem->TypeLetterText = FText::FromString(NewItem->AssetType.Left(1).ToUpper());
+	NewItem->SizeText = FText::FromString(FormatFileSize(NewItem->FileSize));
+	NewItem->ExtensionText = FText::FromString(TEXT(".") + Extension);
+	return NewItem;
+}
+
+FString FFastAssetsSharedCatalog::DetermineAssetType(const FString& Extension)
+{
+	// 3D Models
+	if (Extension == TEXT("fbx") || Extension == TEXT("obj") ||
+		Extension == TEXT("gltf") || Extension == TEXT("glb") ||
+		Extension == TEXT("usd") || Extension == TEXT("usda") ||
+		Extension == TEXT("usdc") || Extension == TEXT("abc"))
+	{
+		return TEXT("Mesh");
+	}
+
+	// Audio
+	if (Extension == TEXT("wav") || Extension == TEXT("mp3") ||
+		Extension == TEXT("ogg") || Extension == TEXT("flac") ||
+		Extension == TEXT("aiff"))
+	{
+		return TEXT("Sound");
+	}
+
+	// Textures
+	if (Extension == TEXT("png") || Extension == TEXT("jpg") ||
+		Extension == TEXT("jpeg") || Extension == TEXT("tga") ||
+		Extension == TEXT("bmp") || Extension == TEXT("exr") ||
+		Extension == TEXT("hdr") || Extension == TEXT("psd") ||
+		Extension == TEXT("tiff"))
+	{
+		return TEXT("Texture");
+	}
+
+	// Unreal Assets
+	if (Extension == TEXT("uasset"))
+	{
+		return TEXT("UAsset");
+	}
+
+	if (Extension == TEXT("umap"))
+	{
+		return TEXT("Map");
+	}
+
+	// Data
+	if (Extension == TEXT("json") || Extension == TEXT("csv"))
+	{
+		return TEXT("Data");
+	}
+
+	return TEXT("Other");
+}
+
+FString FFastAssetsSharedCatalog::FormatFileSize(int64 SizeInBytes)
+{
+	if (SizeInBytes < 1024)
+	{
+		return FString::Printf(TEXT("%lld B"), SizeInBytes);
+	}
+	else if (SizeInBytes < 1024 * 1024)
+	{
+		return FString::Printf(TEXT("%.1f KB"), SizeInBytes / 1024.0);
+	}
+	else if (SizeInBytes < 1024 * 1024 * 1024)
+	{
+		return FString::Printf(TEXT("%.1f MB"), SizeInBytes / (1024.0 * 1024.0));
+	}
+	else
+	{
+		return FString::Printf(TEXT("%.1f GB"), SizeInBytes / (1024.0 * 1024.0 * 1024.0));
+	}
+}
+
@@ -1,24 +1,100 @@
 // Copyright Ismail Faruk Kocademir. All Rights Reserved.
 
 #include "FastAssetsThumbnail.h"
+#include "SFastAssetsWindow.h"
+#include "FastAssetsSettings.h"
+#include "FastAssetsUpdateApplier.h"
+#include "FastAssetsImageProcessing.h"
+#include "FastAssetsImageDecoders.h"
+#include "FastAssetsThumbnailDiskCache.h"
+#include "FastAssetsMeshLoader.h"
+#include "FastAssetsMeshRasterizer.h"
+#include "FastAssetsAudioWaveform.h"
+#include "FastAssetsWorkerProcessPool.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
 #include "IImageWrapperModule.h"
 #include "IImageWrapper.h"
+#include "ImageCore.h"
 #include "Modules/ModuleManager.h"
-#include "Engine/Texture2D.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "CoreGlobals.h"
+#include "Misc/CoreDelegates.h"
 #include "Styling/AppStyle.h"
 #include "Styling/SlateStyleRegistry.h"
 
 TUniquePtr<FFastAssetsThumbnail> FFastAssetsThumbnail::Instance = nullptr;
 
+int32 FastAssetsThumbnailTier::ForSize(int32 DrawSize)
+{
+	for (int32 Tier = 0; Tier < Num - 1; Tier++)
+	{
+		if (GetSize(Tier) >= DrawSize)
+		{
+			return Tier;
+		}
+	}
+	return Num - 1;
+}
+
+bool FFastAssetsThumbnail::FCacheEntry::HasAnyTier() const
+{
+	for (const TSharedPtr<FSlateBrush>& Brush : Brushes)
+	{
+		if (Brush.IsValid())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 FFastAssetsThumbnail::FFastAssetsThumbnail()
+	: bTrimRequested(false)
+	, StatusMap(MakeShared<FStatusMap, ESPMode::ThreadSafe>())
+	, DecodedQueue(MakeShared<FDecodedThumbnailQueue, ESPMode::ThreadSafe>())
+	, ImageWrapperModule(nullptr)
 {
 	InitializeAssetTypeIcons();
+
+	// Load the module here on the game thread; workers only create wrappers from it
+	ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+
+	const UFastAssetsSettings* Settings = UFastAssetsSettings::Get();
+	for (int32 Tier = 0; Tier < FastAssetsThumbnailTier::Num; Tier++)
+	{
+		Atlases[Tier] = MakeUnique<FFastAssetsThumbnailAtlas>(FastAssetsThumbnailTier::GetSize(Tier));
+	}
+	Scheduler = MakeUnique<FFastAssetsThumbnailScheduler>(FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+
+	if (Settings->bEnableDiskThumbnailCache)
+	{
+		DiskCache = MakeShared<FFastAssetsThumbnailDiskCache, ESPMode::ThreadSafe>(
+			FFastAssetsThumbnailDiskCache::GetDefaultCacheDirectory(),
+			Settings->GetDiskThumbnailCacheBudgetBytes());
+	}
+
+	if (Settings->bDecodeThumbnailsOutOfProcess)
+	{
+		WorkerPool = MakeShared<FFastAssetsWorkerProcessPool, ESPMode::ThreadSafe>(FMath::Max(Settings->ThumbnailHelperProcesses, 1), DecodeSize);
+	}
+
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFastAssetsThumbnail::Tick));
+	UploadSourceHandle = FFastAssetsUpdateApplier::Get().AddSource(FFastAssetsUpdateApplier::FApplyNext::CreateRaw(this, &FFastAssetsThumbnail::ApplyNextUpload));
+	PublishSourceHandle = FFastAssetsUpdateApplier::Get().AddSource(FFastAssetsUpdateApplier::FApplyNext::CreateRaw(this, &FFastAssetsThumbnail::PublishNextAtlasPage));
+	MemoryTrimHandle = FCoreDelegates::GetMemoryTrimDelegate().AddRaw(this, &FFastAssetsThumbnail::OnMemoryTrim);
 }
 
 FFastAssetsThumbnail::~FFastAssetsThumbnail()
 {
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	FFastAssetsUpdateApplier::Get().RemoveSource(UploadSourceHandle);
+	FFastAssetsUpdateApplier::Get().RemoveSource(PublishSourceHandle);
+	Scheduler->CancelAll();
 	ClearCache();
 }
 
@@ -26,15 +102,23 @@ FFastAssetsThumbnail& FFastAssetsThumbnail::Get()
 {
 	if (!Instance.IsValid())
 	{
+		// Loads modules and registers tickers, so the first call must come from the game thread
+		check(IsInGameThread());
 		Instance = MakeUnique<FFastAssetsThumbnail>();
 	}
 	return *Instance;
 }
 
+void FFastAssetsThumbnail::Shutdown()
+{
+	Instance.Reset();
+}
+
 void FFastAssetsThumbnail::InitializeAssetTypeIcons()
 {
 	// Create colored brushes for different asset types using FSlateColorBrush
 	// which properly renders a solid color without needing an external texture
+	const int32 ThumbnailSize = UFastAssetsSettings::Get()->GetThumbnailSizePixels();
 
 	// Mesh icon - Blue/Cyan
 	{
@@ -105,35 +189,72 @@ bool FFastAssetsThumbnail::SupportsImageThumbnail(const FString& AssetType) cons
 	return AssetType == TEXT("Texture");
 }
 
-const FSlateBrush* FFastAssetsThumbnail::GetThumbnailBrush(const FString& FilePath, const FString& AssetType)
+bool FFastAssetsThumbnail::SupportsThumbnail(const FString& FilePath, const FString& AssetType) const
 {
-	UE_LOG(LogTemp, Verbose, TEXT("FastAssets: GetThumbnailBrush called for: %s (Type: %s)"), *FilePath, *AssetType);
-
-	// For textures, try to load actual image thumbnail
 	if (SupportsImageThumbnail(AssetType))
 	{
-		// Check cache first
-		if (TSharedPtr<FSlateBrush>* CachedBrush = ThumbnailCache.Find(FilePath))
-		{
-			if (CachedBrush->IsValid())
-			{
-				return CachedBrush->Get();
-			}
-		}
+		return true;
+	}
+
+	const FString Extension = FPaths::GetExtension(FilePath);
+	return (AssetType == TEXT("Mesh") && FastAssetsMeshLoader::IsSupportedExtension(Extension))
+		|| (AssetType == TEXT("Sound") && FastAssetsAudioWaveform::IsSupportedExtension(Extension));
+}
+
+bool FFastAssetsThumbnail::IsThumbnailCached(const FString& FilePath, int32 Tier) const
+{
+	FFastAssetsThumbnailStatus Status;
+	return StatusMap->Find(FilePath, Status) && (Status.ResidentTiers & (1 << Tier)) != 0;
+}
 
-		// Try to load the image
-		TSharedPtr<FSlateBrush> LoadedBrush = LoadImageAsBrush(FilePath);
-		if (LoadedBrush.IsValid())
+bool FFastAssetsThumbnail::HasThumbnailFailed(const FString& FilePath) const
+{
+	FFastAssetsThumbnailStatus Status;
+	return StatusMap->Find(FilePath, Status) && Status.bFailed;
+}
+
+const FSlateBrush* FFastAssetsThumbnail::GetThumbnailBrush(const FString& FilePath, const FString& AssetType)
+{
+	// For textures, meshes and sounds, return the cached thumbnail or start decoding it in the background
+	if (SupportsThumbnail(FilePath, AssetType))
+	{
+		const int32 Tier = GetGridTier();
+		if (FCacheEntry* Entry = FindAndTouch(FilePath, Tier))
 		{
-			ThumbnailCache.Add(FilePath, LoadedBrush);
-			return LoadedBrush.Get();
+			return Entry->Brushes[Tier].Get();
 		}
+
+		QueueDecode(FilePath, nullptr, Tier, EFastAssetsThumbnailPriority::Background);
 	}
 
 	// Fall back to asset type icon
 	return GetAssetTypeIcon(AssetType);
 }
 
+const FSlateBrush* FFastAssetsThumbnail::RequestThumbnail(const TSharedPtr<FExternalAssetItem>& Item, int32 Tier, EFastAssetsThumbnailPriority Priority)
+{
+	if (!Item.IsValid() || !SupportsThumbnail(Item->FilePath, Item->AssetType))
+	{
+		return nullptr;
+	}
+
+	Tier = FMath::Clamp(Tier, 0, FastAssetsThumbnailTier::Num - 1);
+	if (FCacheEntry* Entry = FindAndTouch(Item->FilePath, Tier))
+	{
+		AssignToItem(*Entry, Item);
+		return Item->ThumbnailBrushes[Tier];
+	}
+
+	// The tile shows its placeholder until FinishThumbnail fills in the brush
+	QueueDecode(Item->FilePath, Item, Tier, Priority);
+	return nullptr;
+}
+
+int32 FFastAssetsThumbnail::GetGridTier()
+{
+	return FastAssetsThumbnailTier::ForSize(UFastAssetsSettings::Get()->GetThumbnailSizePixels());
+}
+
 const FSlateBrush* FFastAssetsThumbnail::GetAssetTypeIcon(const FString& AssetType)
 {
 	if (TSharedPtr<FSlateBrush>* IconBrush = AssetTypeIcons.Find(AssetType))
@@ -144,16 +265,222 @@ const FSlateBrush* FFastAssetsThumbnail::GetAssetTypeIcon(const FString& AssetTy
 	return DefaultBrush.Get();
 }
 
-TSharedPtr<FSlateBrush> FFastAssetsThumbnail::LoadImageAsBrush(const FString& FilePath)
+bool FFastAssetsThumbnail::QueueDecode(const FString& FilePath, const TSharedPtr<FExternalAssetItem>& Waiter, int32 Tier, EFastAssetsThumbnailPriority Priority)
 {
-	// Load image data from file
-	TArray<uint8> FileData;
-	if (!FFileHelper::LoadFileToArray(FileData, *FilePath))
+	if (HasThumbnailFailed(FilePath))
 	{
-		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to load file: %s"), *FilePath);
-		return nullptr;
+		return false;
 	}
 
+	FPendingDecode& Pending = PendingDecodes.FindOrAdd(FilePath);
+	Pending.TopTier = FMath::Max(Pending.TopTier, Tier);
+	if (Waiter.IsValid())
+	{
+		Pending.Waiters.AddUnique(Waiter);
+	}
+
+	Scheduler->Request(FilePath, Priority);
+	return true;
+}
+
+void FFastAssetsThumbnail::StartDecode(const FString& FilePath, const FFastAssetsCancelFlag& CancelFlag)
+{
+	// Always decode the largest tier; smaller tiers are scaled from it, so no view size needs a decode of its own
+	const int32 MaxSize = DecodeSize;
+
+	// Items carry size and timestamp from the scan, so a disk cache hit needs no source file access
+	uint64 DiskKey = 0;
+	const FPendingDecode* Pending = PendingDecodes.Find(FilePath);
+	const uint8 WantedTiers = (uint8)((2 << (Pending ? Pending->TopTier : 0)) - 1);
+	if (DiskCache.IsValid() && Pending)
+	{
+		for (const TWeakPtr<FExternalAssetItem>& WeakWaiter : Pending->Waiters)
+		{
+			if (TSharedPtr<FExternalAssetItem> Waiter = WeakWaiter.Pin())
+			{
+				DiskKey = FFastAssetsThumbnailDiskCache::MakeKey(FilePath, Waiter->FileSize, Waiter->ModifiedTime, MaxSize);
+				break;
+			}
+		}
+	}
+
+	// Workers only see shared state, never this object, so shutdown is safe while decodes are in flight
+	TSharedRef<FDecodedThumbnailQueue, ESPMode::ThreadSafe> Queue = DecodedQueue;
+	TSharedPtr<FFastAssetsThumbnailDiskCache, ESPMode::ThreadSafe> WorkerDiskCache = DiskCache;
+	TSharedPtr<FFastAssetsWorkerProcessPool, ESPMode::ThreadSafe> WorkerProcessPool = WorkerPool;
+	TSharedRef<FStatusMap, ESPMode::ThreadSafe> WorkerStatusMap = StatusMap;
+	IImageWrapperModule* WrapperModule = ImageWrapperModule;
+
+	Async(EAsyncExecution::ThreadPool, [Queue, WorkerDiskCache, WorkerProcessPool, WorkerStatusMap, WrapperModule, FilePath, MaxSize, DiskKey, WantedTiers, CancelFlag]()
+	{
+		FFastAssetsDecodedThumbnail Decoded;
+		Decoded.FilePath = FilePath;
+
+		// Another request may have uploaded everything we were asked for while this one waited in the pool
+		FFastAssetsThumbnailStatus Status;
+		const bool bAlreadyResident = WorkerStatusMap->Find(FilePath, Status) && (Status.ResidentTiers & WantedTiers) == WantedTiers;
+
+		if (*CancelFlag || bAlreadyResident)
+		{
+			Decoded.bCancelled = true;
+			Queue->Enqueue(MoveTemp(Decoded));
+			return;
+		}
+
+		uint64 Key = DiskKey;
+		if (WorkerDiskCache.IsValid())
+		{
+			if (Key == 0)
+			{
+				// Requested by path only, stat the file to build the key
+				Key = FFastAssetsThumbnailDiskCache::MakeKey(FilePath, IFileManager::Get().FileSize(*FilePath), IFileManager::Get().GetTimeStamp(*FilePath), MaxSize);
+			}
+
+			if (WorkerDiskCache->Load(Key, Decoded.Width, Decoded.Height, Decoded.Pixels))
+			{
+				BuildTiers(Decoded);
+				Queue->Enqueue(MoveTemp(Decoded));
+				return;
+			}
+		}
+
+		// Sounds stay in process: they stream in fixed-size chunks and reuse peaks from the disk cache
+		FFastAssetsWorkerProcessPool::EResult PoolResult = FFastAssetsWorkerProcessPool::EResult::Unavailable;
+		if (WorkerProcessPool.IsValid() && !FastAssetsAudioWaveform::IsSupportedExtension(FPaths::GetExtension(FilePath)))
+		{
+			PoolResult = WorkerProcessPool->Decode(FilePath, *CancelFlag, Decoded.Pixels, Decoded.Width, Decoded.Height);
+		}
+
+		const bool bDecoded = PoolResult == FFastAssetsWorkerProcessPool::EResult::Unavailable
+			? DecodeThumbnail(*WrapperModule, WorkerDiskCache.Get(), FilePath, MaxSize, CancelFlag, Decoded)
+			: PoolResult == FFastAssetsWorkerProcessPool::EResult::Decoded;
+
+		if (bDecoded && WorkerDiskCache.IsValid())
+		{
+			WorkerDiskCache->Store(Key, Decoded.Width, Decoded.Height, Decoded.Pixels);
+		}
+		Decoded.bCancelled = Decoded.Pixels.Num() == 0 && *CancelFlag;
+		BuildTiers(Decoded);
+		Queue->Enqueue(MoveTemp(Decoded));
+	});
+}
+
+void FFastAssetsThumbnail::BuildTiers(FFastAssetsDecodedThumbnail& Decoded)
+{
+	if (Decoded.Pixels.Num() == 0)
+	{
+		return;
+	}
+
+	// Every tier is filtered straight from the decoded image rather than from the tier above it
+	for (int32 Tier = 0; Tier < FastAssetsThumbnailTier::Num; Tier++)
+	{
+		const FIntPoint TierSize = FastAssetsImageProcessing::FitWithin(Decoded.Width, Decoded.Height, FastAssetsThumbnailTier::GetSize(Tier));
+
+		FFastAssetsDecodedThumbnail::FTier& Out = Decoded.Tiers.AddDefaulted_GetRef();
+		Out.Width = TierSize.X;
+		Out.Height = TierSize.Y;
+
+		if (TierSize.X == Decoded.Width && TierSize.Y == Decoded.Height)
+		{
+			Out.Pixels = Decoded.Pixels;
+		}
+		else
+		{
+			Out.Pixels.SetNumUninitialized(TierSize.X * TierSize.Y * 4);
+			FastAssetsImageProcessing::DownscaleBGRA8(Decoded.Pixels.GetData(), Decoded.Width, Decoded.Height, Out.Pixels.GetData(), TierSize.X, TierSize.Y);
+		}
+	}
+
+	Decoded.Pixels.Empty();
+}
+
+bool FFastAssetsThumbnail::DecodeStandalone(const FString& FilePath, int32 MaxSize, FFastAssetsDecodedThumbnail& OutDecoded)
+{
+	IImageWrapperModule& WrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
+	const FFastAssetsCancelFlag NeverCancelled = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+
+	OutDecoded.FilePath = FilePath;
+	return DecodeThumbnail(WrapperModule, nullptr, FilePath, MaxSize, NeverCancelled, OutDecoded);
+}
+
+bool FFastAssetsThumbnail::DecodeThumbnail(IImageWrapperModule& WrapperModule, FFastAssetsThumbnailDiskCache* DiskCache, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded)
+{
+	const FString Extension = FPaths::GetExtension(FilePath);
+	if (FastAssetsMeshLoader::IsSupportedExtension(Extension))
+	{
+		return DecodeMesh(FilePath, MaxSize, CancelFlag, OutDecoded);
+	}
+
+	if (FastAssetsAudioWaveform::IsSupportedExtension(Extension))
+	{
+		return DecodeAudio(DiskCache, FilePath, MaxSize, CancelFlag, OutDecoded);
+	}
+
+	return DecodeImage(WrapperModule, FilePath, MaxSize, CancelFlag, OutDecoded);
+}
+
+bool FFastAssetsThumbnail::DecodeMesh(const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded)
+{
+	// Past this, a thumbnail-sized render gains nothing and loading dominates; the loader keeps an even subset
+	static constexpr int32 MaxThumbnailTriangles = 250000;
+
+	FFastAssetsMeshData Mesh;
+	if (!FastAssetsMeshLoader::LoadMesh(FilePath, MaxThumbnailTriangles, Mesh))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to load mesh for thumbnail: %s"), *FilePath);
+		return false;
+	}
+
+	if (*CancelFlag)
+	{
+		return false;
+	}
+
+	if (!FastAssetsMeshRasterizer::RenderThumbnail(Mesh, MaxSize, OutDecoded.Pixels))
+	{
+		return false;
+	}
+
+	OutDecoded.Width = MaxSize;
+	OutDecoded.Height = MaxSize;
+	return true;
+}
+
+bool FFastAssetsThumbnail::DecodeAudio(FFastAssetsThumbnailDiskCache* DiskCache, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded)
+{
+	// Peaks are stored next to the rendered thumbnails under a size-independent key (thumbnail size 0),
+	// so a new tile size only redraws them instead of decoding the sound again
+	const uint64 PeaksKey = FFastAssetsThumbnailDiskCache::MakeKey(FilePath, IFileManager::Get().FileSize(*FilePath), IFileManager::Get().GetTimeStamp(*FilePath), 0);
+
+	FFastAssetsWaveformPeaks Peaks;
+	int32 NumBuckets = 0;
+	int32 NumRows = 0;
+	if (!DiskCache || !DiskCache->Load(PeaksKey, NumBuckets, NumRows, Peaks.Buckets))
+	{
+		if (!FastAssetsAudioWaveform::ComputePeaks(FilePath, *CancelFlag, Peaks))
+		{
+			if (!*CancelFlag)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to decode sound for waveform: %s"), *FilePath);
+			}
+			return false;
+		}
+
+		if (DiskCache)
+		{
+			DiskCache->Store(PeaksKey, Peaks.Num(), 1, Peaks.Buckets);
+		}
+	}
+
+	FastAssetsAudioWaveform::RenderWaveform(Peaks, MaxSize, MaxSize, OutDecoded.Pixels);
+	OutDecoded.Width = MaxSize;
+	OutDecoded.Height = MaxSize;
+	return true;
+}
+
+bool FFastAssetsThumbnail::DecodeImage(IImageWrapperModule& WrapperModule, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded)
+{
 	// Determine image format from extension
 	FString Extension = FPaths::GetExtension(FilePath).ToLower();
 	EImageFormat ImageFormat = EImageFormat::Invalid;
@@ -182,117 +509,519 @@ TSharedPtr<FSlateBrush> FFastAssetsThumbnail::LoadImageAsBrush(const FString& Fi
 	{
 		ImageFormat = EImageFormat::HDR;
 	}
+	else if (Extension == TEXT("tiff") || Extension == TEXT("tif"))
+	{
+		ImageFormat = EImageFormat::TIFF;
+	}
+
+	// Photoshop files: read the flattened composite and seek past the layers
+	if (Extension == TEXT("psd"))
+	{
+		if (!FastAssetsImageDecoders::DecodePsdComposite(WrapperModule, FilePath, MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to read composite image from: %s"), *FilePath);
+			OutDecoded.Pixels.Empty();
+			return false;
+		}
+
+		FastAssetsImageProcessing::ShrinkToFit(OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height, MaxSize);
+		return true;
+	}
+
+	// TIFF: decode a reduced subfile or sampled rows; ImageWrapper remains the fallback
+	if (ImageFormat == EImageFormat::TIFF &&
+		FastAssetsImageDecoders::DecodeTiffReduced(FilePath, MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height))
+	{
+		FastAssetsImageProcessing::ShrinkToFit(OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height, MaxSize);
+		return true;
+	}
 
 	if (ImageFormat == EImageFormat::Invalid)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Unsupported image format for: %s"), *FilePath);
-		return nullptr;
+		return false;
+	}
+
+	// Large EXRs: read only a mip level or a subset of scanlines that still covers the thumbnail
+	if (ImageFormat == EImageFormat::EXR)
+	{
+		TArray<FFloat16Color> Reduced;
+		int32 ReducedWidth = 0;
+		int32 ReducedHeight = 0;
+		if (FastAssetsImageDecoders::DecodeExrReduced(FilePath, MaxSize, Reduced, ReducedWidth, ReducedHeight))
+		{
+			FastAssetsImageProcessing::ToneMapHalf(Reduced.GetData(), ReducedWidth, ReducedHeight, MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height);
+			return true;
+		}
 	}
 
-	// Get image wrapper module
-	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(TEXT("ImageWrapper"));
-	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+	TUniquePtr<IFileHandle> File(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+	if (!File.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to load file: %s"), *FilePath);
+		return false;
+	}
+
+	const int64 FileSize = File->Size();
+	TArray<uint8> FileData;
 
+	if (ImageFormat == EImageFormat::JPEG)
+	{
+		// Photos usually carry an EXIF preview near the start, which saves reading the rest of the file
+		const int64 HeadSize = FMath::Min(FileSize, FastAssetsImageDecoders::JpegHeadBytes);
+		FileData.SetNumUninitialized(HeadSize);
+		if (!File->Read(FileData.GetData(), HeadSize))
+		{
+			return false;
+		}
+
+		if (FastAssetsImageDecoders::DecodeExifThumbnail(WrapperModule, FileData.GetData(), FileData.Num(), MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height))
+		{
+			FastAssetsImageProcessing::ShrinkToFit(OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height, MaxSize);
+			return true;
+		}
+	}
+
+	// Read the rest of the file
+	const int64 AlreadyRead = FileData.Num();
+	FileData.SetNumUninitialized(FileSize);
+	if (!File->Read(FileData.GetData() + AlreadyRead, FileSize - AlreadyRead))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to load file: %s"), *FilePath);
+		return false;
+	}
+	File.Reset();
+
+	// The read is usually the slow part, so check again before spending time on the decode
+	if (*CancelFlag)
+	{
+		return false;
+	}
+
+	// Let the IDCT produce a reduced image directly instead of decoding every pixel
+	if (ImageFormat == EImageFormat::JPEG &&
+		FastAssetsImageDecoders::DecodeJpegScaled(FileData.GetData(), FileData.Num(), MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height))
+	{
+		FileData.Empty();
+		FastAssetsImageProcessing::ShrinkToFit(OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height, MaxSize);
+		return true;
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = WrapperModule.CreateImageWrapper(ImageFormat);
 	if (!ImageWrapper.IsValid())
 	{
-		return nullptr;
+		return false;
 	}
 
 	// Decompress the image
 	if (!ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to decompress image: %s"), *FilePath);
-		return nullptr;
+		return false;
+	}
+
+	// Float sources are tone mapped from their native format instead of being clipped to BGRA8
+	if (ImageFormat == EImageFormat::EXR || ImageFormat == EImageFormat::HDR)
+	{
+		FImage RawImage;
+		if (!ImageWrapper->GetRawImage(RawImage))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to get raw data from image: %s"), *FilePath);
+			return false;
+		}
+		ImageWrapper.Reset();
+		FileData.Empty();
+
+		if (RawImage.Format == ERawImageFormat::RGBA16F)
+		{
+			FastAssetsImageProcessing::ToneMapHalf(RawImage.AsRGBA16F().GetData(), RawImage.SizeX, RawImage.SizeY, MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height);
+		}
+		else
+		{
+			RawImage.ChangeFormat(ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+			FastAssetsImageProcessing::ToneMapFloat(RawImage.AsRGBA32F().GetData(), RawImage.SizeX, RawImage.SizeY, MaxSize, OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height);
+		}
+		return true;
 	}
 
 	// Get raw data
-	TArray<uint8> RawData;
-	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
+	if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutDecoded.Pixels))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to get raw data from image: %s"), *FilePath);
-		return nullptr;
+		OutDecoded.Pixels.Empty();
+		return false;
 	}
 
-	// Create texture
-	int32 Width = ImageWrapper->GetWidth();
-	int32 Height = ImageWrapper->GetHeight();
+	OutDecoded.Width = ImageWrapper->GetWidth();
+	OutDecoded.Height = ImageWrapper->GetHeight();
+
+	// Free the source-sized buffers before scaling down to thumbnail resolution
+	ImageWrapper.Reset();
+	FileData.Empty();
+
+	FastAssetsImageProcessing::ShrinkToFit(OutDecoded.Pixels, OutDecoded.Width, OutDecoded.Height, MaxSize);
+	return true;
+}
 
-	// Calculate thumbnail size (maintain aspect ratio)
-	int32 ThumbWidth = ThumbnailSize;
-	int32 ThumbHeight = ThumbnailSize;
+bool FFastAssetsThumbnail::Tick(float DeltaTime)
+{
+	// Anything evicted last tick has had a full frame to drop out of Slate's draw lists
+	RetiredBrushes.Reset();
 
-	if (Width > Height)
+	if (bTrimRequested.exchange(false))
 	{
-		ThumbHeight = FMath::RoundToInt((float)ThumbnailSize * Height / Width);
+		TrimCache(0);
 	}
 	else
 	{
-		ThumbWidth = FMath::RoundToInt((float)ThumbnailSize * Width / Height);
+		// Pages added over budget while everything was visible are released once they scroll away
+		const int64 BudgetBytes = UFastAssetsSettings::Get()->GetThumbnailCacheBudgetBytes();
+		if (GetCacheSizeBytes() > BudgetBytes)
+		{
+			TrimCache(BudgetBytes);
+		}
+	}
+
+	// Start the most wanted decodes; requests that were not renewed are dropped here
+	Scheduler->Update(
+		[this](const FString& FilePath, const FFastAssetsCancelFlag& CancelFlag)
+		{
+			StartDecode(FilePath, CancelFlag);
+		},
+		[this](const FString& FilePath)
+		{
+			PendingDecodes.Remove(FilePath);
+		});
+
+	return true;
+}
+
+bool FFastAssetsThumbnail::PublishNextAtlasPage()
+{
+	for (const TUniquePtr<FFastAssetsThumbnailAtlas>& Atlas : Atlases)
+	{
+		if (Atlas->PublishNextPage())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FFastAssetsThumbnail::ApplyNextUpload()
+{
+	FFastAssetsDecodedThumbnail Decoded;
+	if (!DecodedQueue->Dequeue(Decoded))
+	{
+		return false;
+	}
+
+	FinishThumbnail(Decoded);
+	return true;
+}
+
+void FFastAssetsThumbnail::FinishThumbnail(FFastAssetsDecodedThumbnail& Decoded)
+{
+	Scheduler->OnJobFinished(Decoded.FilePath);
+
+	FPendingDecode Pending;
+	PendingDecodes.RemoveAndCopyValue(Decoded.FilePath, Pending);
+
+	if (Decoded.bCancelled)
+	{
+		// Requested again the next time its tile is drawn
+		return;
+	}
+
+	if (Decoded.Tiers.Num() == 0)
+	{
+		StatusMap->Update(Decoded.FilePath, [](FFastAssetsThumbnailStatus& Status)
+		{
+			Status.bFailed = true;
+			return true;
+		});
+		return;
+	}
+
+	// Upload every tier up to the largest one asked for, so smaller views are served without another request
+	for (int32 Tier = 0; Tier <= Pending.TopTier && Tier < Decoded.Tiers.Num(); Tier++)
+	{
+		const FCacheEntry* Existing = ThumbnailCache.Find(Decoded.FilePath);
+		if (Existing && Existing->Brushes[Tier].IsValid())
+		{
+			continue;
+		}
+
+		FFastAssetsAtlasSlot Slot;
+		if (!AllocateAtlasSlot(Tier, Decoded.FilePath, Slot))
+		{
+			// Out of texture memory, leave the missing tiers to be retried later
+			break;
+		}
+
+		const FFastAssetsDecodedThumbnail::FTier& TierPixels = Decoded.Tiers[Tier];
+		FFastAssetsThumbnailAtlas& Atlas = *Atlases[Tier];
+		Atlas.Upload(Slot, TierPixels.Pixels.GetData(), TierPixels.Width, TierPixels.Height);
+
+		TSharedPtr<FSlateBrush> NewBrush = MakeShared<FSlateBrush>();
+		Atlas.ApplyToBrush(Slot, TierPixels.Width, TierPixels.Height, *NewBrush);
+
+		// Found again after the allocation, which may have evicted other tiers of this file
+		FCacheEntry& Entry = ThumbnailCache.FindOrAdd(Decoded.FilePath);
+		Entry.Brushes[Tier] = NewBrush;
+		Entry.Slots[Tier] = Slot;
+		Atlas.TouchPage(Slot.Page);
+
+		StatusMap->Update(Decoded.FilePath, [Tier](FFastAssetsThumbnailStatus& Status)
+		{
+			Status.ResidentTiers |= 1 << Tier;
+			return true;
+		});
+
+		UE_LOG(LogTemp, Verbose, TEXT("FastAssets: Uploaded thumbnail for: %s (%dx%d) to tier %d atlas page %d"), *Decoded.FilePath, TierPixels.Width, TierPixels.Height, Tier, Slot.Page);
+	}
+
+	if (FCacheEntry* Entry = ThumbnailCache.Find(Decoded.FilePath))
+	{
+		for (const TWeakPtr<FExternalAssetItem>& WeakItem : Pending.Waiters)
+		{
+			AssignToItem(*Entry, WeakItem.Pin());
+		}
+	}
+}
+
+bool FFastAssetsThumbnail::AllocateAtlasSlot(int32 Tier, const FString& FilePath, FFastAssetsAtlasSlot& OutSlot)
+{
+	FFastAssetsThumbnailAtlas& Atlas = *Atlases[Tier];
+	if (Atlas.AllocateSlot(FilePath, OutSlot))
+	{
+		return true;
 	}
 
-	// Create texture
-	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
-	if (!Texture)
+	// Grow while under budget; the budget covers the pages of every tier
+	const int64 BudgetBytes = UFastAssetsSettings::Get()->GetThumbnailCacheBudgetBytes();
+	if (Atlas.GetNumPages() == 0 || GetCacheSizeBytes() + Atlas.GetPageSizeBytes() <= BudgetBytes)
+	{
+		return Atlas.AddPage() != INDEX_NONE && Atlas.AllocateSlot(FilePath, OutSlot);
+	}
+
+	// At budget, take the least recently used page of any tier that is not on screen.
+	// Pages of the same tier are recycled in place, others are released to make room for a new one.
+	for (const FTierPage& Page : GetPagesByAge())
+	{
+		if (!IsPageOnScreen(Page))
+		{
+			if (Page.Tier == Tier)
+			{
+				EvictPage(Page, false);
+				return Atlas.AllocateSlot(FilePath, OutSlot);
+			}
+
+			EvictPage(Page, true);
+			return Atlas.AddPage() != INDEX_NONE && Atlas.AllocateSlot(FilePath, OutSlot);
+		}
+	}
+
+	// Everything is visible, go over budget rather than blank a visible tile; TrimCache pulls it back later
+	return Atlas.AddPage() != INDEX_NONE && Atlas.AllocateSlot(FilePath, OutSlot);
+}
+
+FFastAssetsThumbnail::FCacheEntry* FFastAssetsThumbnail::FindAndTouch(const FString& FilePath, int32 Tier)
+{
+	FCacheEntry* Entry = ThumbnailCache.Find(FilePath);
+	if (!Entry || !Entry->Brushes[Tier].IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to create transient texture for: %s"), *FilePath);
 		return nullptr;
 	}
 
-	// Prevent garbage collection
-	Texture->AddToRoot();
+	Atlases[Tier]->TouchPage(Entry->Slots[Tier].Page);
+	return Entry;
+}
 
-	// Lock and copy data
-	void* TextureData = Texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-	FMemory::Memcpy(TextureData, RawData.GetData(), RawData.Num());
-	Texture->GetPlatformData()->Mips[0].BulkData.Unlock();
+void FFastAssetsThumbnail::AssignToItem(FCacheEntry& Entry, const TSharedPtr<FExternalAssetItem>& Item)
+{
+	if (!Item.IsValid())
+	{
+		return;
+	}
 
-	// Update resource
-	Texture->UpdateResource();
+	for (int32 Tier = 0; Tier < FastAssetsThumbnailTier::Num; Tier++)
+	{
+		Item->ThumbnailBrushes[Tier] = Entry.Brushes[Tier].Get();
+	}
 
-	// Store texture reference
-	TextureCache.Add(FilePath, Texture);
+	// Drop owners from previous scans while we are here
+	Entry.Owners.RemoveAll([](const TWeakPtr<FExternalAssetItem>& Owner) { return !Owner.IsValid(); });
+	Entry.Owners.AddUnique(Item);
+}
 
-	UE_LOG(LogTemp, Log, TEXT("FastAssets: Successfully loaded thumbnail for: %s (%dx%d)"), *FilePath, Width, Height);
+bool FFastAssetsThumbnail::IsOnScreen(const FCacheEntry& Entry, int32 Tier) const
+{
+	for (const TWeakPtr<FExternalAssetItem>& WeakOwner : Entry.Owners)
+	{
+		TSharedPtr<FExternalAssetItem> Owner = WeakOwner.Pin();
+		if (Owner.IsValid() && Owner->ThumbnailBrushes[Tier] == Entry.Brushes[Tier].Get() && Owner->ThumbnailLastDrawnFrames[Tier] + 2 >= GFrameCounter)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FFastAssetsThumbnail::IsPageOnScreen(const FTierPage& Page) const
+{
+	for (const FString& FilePath : Atlases[Page.Tier]->GetSlotKeys(Page.Page))
+	{
+		const FCacheEntry* Entry = FilePath.IsEmpty() ? nullptr : ThumbnailCache.Find(FilePath);
+		if (Entry && IsOnScreen(*Entry, Page.Tier))
+		{
+			return true;
+		}
+	}
+	return false;
+}
 
-	// Create brush from texture
-	TSharedPtr<FSlateBrush> NewBrush = MakeShared<FSlateBrush>();
-	NewBrush->SetResourceObject(Texture);
-	NewBrush->ImageSize = FVector2D(ThumbWidth, ThumbHeight);
-	NewBrush->DrawAs = ESlateBrushDrawType::Image;
-	NewBrush->Tiling = ESlateBrushTileType::NoTile;
+TArray<FFastAssetsThumbnail::FTierPage> FFastAssetsThumbnail::GetPagesByAge() const
+{
+	TArray<FTierPage> Pages;
+	for (int32 Tier = 0; Tier < FastAssetsThumbnailTier::Num; Tier++)
+	{
+		for (int32 PageIndex : Atlases[Tier]->GetPagesByAge())
+		{
+			FTierPage& Page = Pages.AddDefaulted_GetRef();
+			Page.Tier = Tier;
+			Page.Page = PageIndex;
+		}
+	}
 
-	return NewBrush;
+	Pages.Sort([this](const FTierPage& A, const FTierPage& B)
+	{
+		return Atlases[A.Tier]->GetPageLastUsed(A.Page) < Atlases[B.Tier]->GetPageLastUsed(B.Page);
+	});
+	return Pages;
 }
 
-UTexture2D* FFastAssetsThumbnail::CreateTextureFromImage(const FString& FilePath)
+int64 FFastAssetsThumbnail::GetCacheSizeBytes() const
 {
-	// This is a simplified version - the actual loading is in LoadImageAsBrush
-	return nullptr;
+	int64 Bytes = 0;
+	for (const TUniquePtr<FFastAssetsThumbnailAtlas>& Atlas : Atlases)
+	{
+		Bytes += Atlas->GetResidentBytes();
+	}
+	return Bytes;
 }
 
-void FFastAssetsThumbnail::ClearCache()
+void FFastAssetsThumbnail::TrimCache(int64 BudgetBytes)
 {
-	ThumbnailCache.Empty();
+	// Whole pages are released, oldest first across all tiers; pages with visible thumbnails are skipped
+	for (const FTierPage& Page : GetPagesByAge())
+	{
+		if (GetCacheSizeBytes() <= BudgetBytes)
+		{
+			break;
+		}
+
+		if (!IsPageOnScreen(Page))
+		{
+			EvictPage(Page, true);
+		}
+	}
+}
+
+void FFastAssetsThumbnail::EvictEntry(const FString& FilePath)
+{
+	for (int32 Tier = 0; Tier < FastAssetsThumbnailTier::Num; Tier++)
+	{
+		EvictTier(FilePath, Tier);
+	}
+}
+
+void FFastAssetsThumbnail::EvictTier(const FString& FilePath, int32 Tier)
+{
+	FCacheEntry* Entry = ThumbnailCache.Find(FilePath);
+	if (!Entry || !Entry->Brushes[Tier].IsValid())
+	{
+		return;
+	}
+
+	// Clear the brush pointer on every item still referencing this tier
+	for (const TWeakPtr<FExternalAssetItem>& WeakOwner : Entry->Owners)
+	{
+		TSharedPtr<FExternalAssetItem> Owner = WeakOwner.Pin();
+		if (Owner.IsValid() && Owner->ThumbnailBrushes[Tier] == Entry->Brushes[Tier].Get())
+		{
+			Owner->ThumbnailBrushes[Tier] = nullptr;
+		}
+	}
+
+	Atlases[Tier]->FreeSlot(Entry->Slots[Tier]);
+	RetiredBrushes.Add(Entry->Brushes[Tier]);
+	Entry->Brushes[Tier].Reset();
+	Entry->Slots[Tier] = FFastAssetsAtlasSlot();
 
-	// Remove textures from root before clearing
-	for (auto& Pair : TextureCache)
+	StatusMap->Update(FilePath, [Tier](FFastAssetsThumbnailStatus& Status)
 	{
-		if (Pair.Value && Pair.Value->IsValidLowLevel())
+		Status.ResidentTiers &= ~(1 << Tier);
+		return Status.ResidentTiers != 0 || Status.bFailed;
+	});
+
+	if (!Entry->HasAnyTier())
+	{
+		ThumbnailCache.Remove(FilePath);
+	}
+}
+
+void FFastAssetsThumbnail::EvictPage(const FTierPage& Page, bool bReleasePage)
+{
+	FFastAssetsThumbnailAtlas& Atlas = *Atlases[Page.Tier];
+
+	// Copy the keys, EvictTier frees slots on the page while we iterate
+	const TArray<FString> SlotKeys = Atlas.GetSlotKeys(Page.Page);
+	for (int32 SlotIndex = 0; SlotIndex < SlotKeys.Num(); SlotIndex++)
+	{
+		if (!SlotKeys[SlotIndex].IsEmpty())
 		{
-			Pair.Value->RemoveFromRoot();
+			EvictTier(SlotKeys[SlotIndex], Page.Tier);
+
+			FFastAssetsAtlasSlot Slot;
+			Slot.Page = Page.Page;
+			Slot.Slot = SlotIndex;
+			Atlas.FreeSlot(Slot);
 		}
 	}
-	TextureCache.Empty();
+
+	if (bReleasePage)
+	{
+		Atlas.ReleasePage(Page.Page);
+	}
+}
+
+void FFastAssetsThumbnail::OnMemoryTrim()
+{
+	// Defer to the game thread tick, where the cache and the items are owned
+	bTrimRequested = true;
+}
+
+void FFastAssetsThumbnail::ClearCache()
+{
+	for (const FTierPage& Page : GetPagesByAge())
+	{
+		EvictPage(Page, true);
+	}
+
+	StatusMap->Empty();
 }
 
 void FFastAssetsThumbnail::PreCacheThumbnails(const TArray<FString>& FilePaths, const TArray<FString>& AssetTypes)
 {
-	// Pre-cache thumbnails for faster display
+	// Queue low priority decodes so thumbnails are ready when tiles are generated
+	const int32 Tier = GetGridTier();
 	for (int32 i = 0; i < FilePaths.Num() && i < AssetTypes.Num(); i++)
 	{
-		if (SupportsImageThumbnail(AssetTypes[i]))
+		const FCacheEntry* Entry = ThumbnailCache.Find(FilePaths[i]);
+		if (SupportsThumbnail(FilePaths[i], AssetTypes[i]) && (!Entry || !Entry->Brushes[Tier].IsValid()))
 		{
-			GetThumbnailBrush(FilePaths[i], AssetTypes[i]);
+			QueueDecode(FilePaths[i], nullptr, Tier, EFastAssetsThumbnailPriority::Background);
 		}
 	}
 }
@@ -0,0 +1,306 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsThumbnailAtlas.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/SlateRenderer.h"
+#include "Slate/SlateTextures.h"
+#include "Textures/SlateShaderResource.h"
+#include "HAL/PlatformTime.h"
+#include "RenderingThread.h"
+#include "RHI.h"
+
+namespace
+{
+	/** Brush that names a dynamic image resource, so Slate looks it up instead of loading a file */
+	struct FAtlasPageBrush : public FSlateBrush
+	{
+		FAtlasPageBrush(FName InResourceName, const FVector2D& InImageSize)
+			: FSlateBrush(ESlateBrushDrawType::Image, InResourceName, FMargin(0.0f), ESlateBrushTileType::NoTile, ESlateBrushImageType::FullColor, InImageSize, FLinearColor::White, nullptr, true)
+		{
+		}
+	};
+
+	FSlateRenderer* GetSlateRenderer()
+	{
+		return FSlateApplication::IsInitialized() ? FSlateApplication::Get().GetRenderer() : nullptr;
+	}
+
+	int32 NextAtlasId = 0;
+}
+
+FFastAssetsThumbnailAtlas::FFastAssetsThumbnailAtlas(int32 InSlotSize)
+	: NumLivePages(0)
+	, AtlasId(NextAtlasId++)
+	, SlotSize(FMath::Clamp(InSlotSize, 1, PageSize - Gutter * 2))
+	, SlotsPerRow(PageSize / (SlotSize + Gutter * 2))
+{
+}
+
+FFastAssetsThumbnailAtlas::~FFastAssetsThumbnailAtlas()
+{
+	for (FPage& Page : Pages)
+	{
+		if (Page.Pixels.Num() > 0)
+		{
+			UnpublishPage(Page);
+		}
+	}
+	Pages.Empty();
+}
+
+FIntPoint FFastAssetsThumbnailAtlas::GetSlotOrigin(int32 Slot) const
+{
+	const int32 Stride = SlotSize + Gutter * 2;
+	return FIntPoint((Slot % SlotsPerRow) * Stride + Gutter, (Slot / SlotsPerRow) * Stride + Gutter);
+}
+
+bool FFastAssetsThumbnailAtlas::AllocateSlot(const FString& Key, FFastAssetsAtlasSlot& OutSlot)
+{
+	// Fill the fullest page first, so emptier pages are the ones that become free to release
+	int32 BestPage = INDEX_NONE;
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		const FPage& Page = Pages[PageIndex];
+		if (IsLive(PageIndex) && Page.NumFree > 0 && (BestPage == INDEX_NONE || Page.NumFree < Pages[BestPage].NumFree))
+		{
+			BestPage = PageIndex;
+		}
+	}
+
+	if (BestPage == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FPage& Page = Pages[BestPage];
+	const int32 FreeSlot = Page.SlotKeys.IndexOfByPredicate([](const FString& SlotKey) { return SlotKey.IsEmpty(); });
+	check(FreeSlot != INDEX_NONE);
+
+	Page.SlotKeys[FreeSlot] = Key;
+	Page.NumFree--;
+
+	OutSlot.Page = BestPage;
+	OutSlot.Slot = FreeSlot;
+	return true;
+}
+
+int32 FFastAssetsThumbnailAtlas::AddPage()
+{
+	// Reuse the index of a released page if there is one
+	int32 PageIndex = Pages.IndexOfByPredicate([](const FPage& Page) { return Page.Pixels.Num() == 0; });
+	if (PageIndex == INDEX_NONE)
+	{
+		PageIndex = Pages.AddDefaulted();
+	}
+
+	FPage& Page = Pages[PageIndex];
+
+	// Start transparent, so unused slots never show garbage
+	Page.Pixels.SetNumZeroed(PageSize * PageSize * 4);
+	Page.Brush = FAtlasPageBrush(*FString::Printf(TEXT("FastAssetsAtlas_%d_%d"), AtlasId, PageIndex), FVector2D(PageSize, PageSize));
+
+	// Created straight away, so brushes handed out before the next publish never name a missing resource
+	if (!CreatePageTexture(Page))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to create thumbnail atlas page"));
+		Page.Pixels.Empty();
+		return INDEX_NONE;
+	}
+
+	Page.SlotKeys.Reset();
+	Page.SlotKeys.SetNum(SlotsPerRow * SlotsPerRow);
+	Page.NumFree = Page.SlotKeys.Num();
+	Page.LastUsed = FPlatformTime::Cycles64();
+
+	NumLivePages++;
+	return PageIndex;
+}
+
+void FFastAssetsThumbnailAtlas::ReleasePage(int32 PageIndex)
+{
+	if (!IsLive(PageIndex))
+	{
+		return;
+	}
+
+	FPage& Page = Pages[PageIndex];
+	check(Page.NumFree == Page.SlotKeys.Num());
+
+	UnpublishPage(Page);
+	Page.Pixels.Empty();
+	Page.SlotKeys.Empty();
+	Page.NumFree = 0;
+	Page.Texture = nullptr;
+	Page.DirtyRect = FIntRect();
+
+	NumLivePages--;
+}
+
+bool FFastAssetsThumbnailAtlas::CreatePageTexture(FPage& Page)
+{
+	FSlateRenderer* Renderer = GetSlateRenderer();
+	if (!Renderer || !Renderer->GenerateDynamicImageResource(Page.Brush.GetResourceName(), PageSize, PageSize, Page.Pixels))
+	{
+		return false;
+	}
+
+	// The RHI renderer backs dynamic images with RHI textures; keep it so later uploads only send what changed
+	const FSlateResourceHandle Handle = Renderer->GetResourceHandle(Page.Brush);
+	const FSlateShaderResourceProxy* Proxy = Handle.GetResourceProxy();
+	if (!Proxy || !Proxy->Resource || Proxy->Resource->GetType() != ESlateShaderResource::NativeTexture)
+	{
+		Renderer->ReleaseDynamicResource(Page.Brush);
+		return false;
+	}
+
+	Page.Texture = static_cast<FSlateTexture2DRHIRef*>(Proxy->Resource);
+	Page.DirtyRect = FIntRect();
+	Page.LastPublished = FPlatformTime::Seconds();
+	return true;
+}
+
+void FFastAssetsThumbnailAtlas::PublishPage(FPage& Page)
+{
+	// Only the dirty rows are copied on the game thread, so a publish costs about what changed rather than the page
+	const FIntRect Rect = Page.DirtyRect;
+	const int32 RowBytes = Rect.Width() * 4;
+
+	TArray<uint8> Staging;
+	Staging.SetNumUninitialized(RowBytes * Rect.Height());
+	for (int32 Y = 0; Y < Rect.Height(); Y++)
+	{
+		FMemory::Memcpy(Staging.GetData() + (int64)Y * RowBytes, Page.Pixels.GetData() + ((int64)(Rect.Min.Y + Y) * PageSize + Rect.Min.X) * 4, RowBytes);
+	}
+
+	// Queued ahead of any release of the page, so the texture is still alive when this runs
+	FSlateTexture2DRHIRef* Texture = Page.Texture;
+	ENQUEUE_RENDER_COMMAND(FastAssetsPublishAtlasPage)([Texture, Rect, Staging = MoveTemp(Staging)](FRHICommandListImmediate& RHICmdList)
+	{
+		const FTexture2DRHIRef& TextureRHI = Texture->GetTypedResource();
+		if (TextureRHI.IsValid())
+		{
+			const FUpdateTextureRegion2D Region(Rect.Min.X, Rect.Min.Y, 0, 0, Rect.Width(), Rect.Height());
+			RHIUpdateTexture2D(TextureRHI, 0, Region, Rect.Width() * 4, Staging.GetData());
+		}
+	});
+
+	Page.DirtyRect = FIntRect();
+	Page.LastPublished = FPlatformTime::Seconds();
+}
+
+void FFastAssetsThumbnailAtlas::UnpublishPage(FPage& Page)
+{
+	if (FSlateRenderer* Renderer = GetSlateRenderer())
+	{
+		Renderer->ReleaseDynamicResource(Page.Brush);
+	}
+}
+
+void FFastAssetsThumbnailAtlas::FreeSlot(const FFastAssetsAtlasSlot& Slot)
+{
+	if (!Slot.IsValid() || !Pages.IsValidIndex(Slot.Page))
+	{
+		return;
+	}
+
+	FPage& Page = Pages[Slot.Page];
+	if (Page.SlotKeys.IsValidIndex(Slot.Slot) && !Page.SlotKeys[Slot.Slot].IsEmpty())
+	{
+		Page.SlotKeys[Slot.Slot].Reset();
+		Page.NumFree++;
+	}
+}
+
+void FFastAssetsThumbnailAtlas::Upload(const FFastAssetsAtlasSlot& Slot, const uint8* Pixels, int32 Width, int32 Height)
+{
+	check(Slot.IsValid() && IsLive(Slot.Page));
+	check(Width > 0 && Height > 0 && Width <= SlotSize && Height <= SlotSize);
+
+	FPage& Page = Pages[Slot.Page];
+	const FIntPoint Origin = GetSlotOrigin(Slot.Slot);
+
+	// Write the thumbnail with its gutter straight into the page, repeating the edge pixels outwards
+	const int32 PaddedWidth = Width + Gutter * 2;
+	const int32 PaddedHeight = Height + Gutter * 2;
+
+	for (int32 Y = 0; Y < PaddedHeight; Y++)
+	{
+		const int32 SrcY = FMath::Clamp(Y - Gutter, 0, Height - 1);
+		const uint8* SrcRow = Pixels + (int64)SrcY * Width * 4;
+		uint8* DstRow = Page.Pixels.GetData() + ((int64)(Origin.Y - Gutter + Y) * PageSize + (Origin.X - Gutter)) * 4;
+
+		FMemory::Memcpy(DstRow + Gutter * 4, SrcRow, Width * 4);
+		for (int32 G = 0; G < Gutter; G++)
+		{
+			FMemory::Memcpy(DstRow + G * 4, SrcRow, 4);
+			FMemory::Memcpy(DstRow + (Gutter + Width + G) * 4, SrcRow + (Width - 1) * 4, 4);
+		}
+	}
+
+	// Grow the dirty region by the slot and its gutter
+	const FIntRect SlotRect(Origin.X - Gutter, Origin.Y - Gutter, Origin.X - Gutter + PaddedWidth, Origin.Y - Gutter + PaddedHeight);
+	if (Page.DirtyRect.Area() > 0)
+	{
+		Page.DirtyRect.Union(SlotRect);
+	}
+	else
+	{
+		Page.DirtyRect = SlotRect;
+	}
+}
+
+void FFastAssetsThumbnailAtlas::ApplyToBrush(const FFastAssetsAtlasSlot& Slot, int32 Width, int32 Height, FSlateBrush& Brush) const
+{
+	check(Slot.IsValid() && IsLive(Slot.Page));
+
+	const FIntPoint Origin = GetSlotOrigin(Slot.Slot);
+	const float InvPageSize = 1.0f / PageSize;
+
+	Brush = Pages[Slot.Page].Brush;
+	Brush.ImageSize = FVector2D(Width, Height);
+	Brush.SetUVRegion(FBox2f(
+		FVector2f(Origin.X * InvPageSize, Origin.Y * InvPageSize),
+		FVector2f((Origin.X + Width) * InvPageSize, (Origin.Y + Height) * InvPageSize)));
+}
+
+void FFastAssetsThumbnailAtlas::TouchPage(int32 PageIndex)
+{
+	if (Pages.IsValidIndex(PageIndex))
+	{
+		Pages[PageIndex].LastUsed = FPlatformTime::Cycles64();
+	}
+}
+
+const TArray<FString>& FFastAssetsThumbnailAtlas::GetSlotKeys(int32 PageIndex) const
+{
+	return Pages[PageIndex].SlotKeys;
+}
+
+TArray<int32> FFastAssetsThumbnailAtlas::GetPagesByAge() const
+{
+	TArray<int32> PageIndices;
+	for (int32 PageIndex = 0; PageIndex < Pages.Num(); PageIndex++)
+	{
+		if (IsLive(PageIndex))
+		{
+			PageIndices.Add(PageIndex);
+		}
+	}
+
+	PageIndices.Sort([this](int32 A, int32 B) { return Pages[A].LastUsed < Pages[B].LastUsed; });
+	return PageIndices;
+}
+
+bool FFastAssetsThumbnailAtlas::PublishNextPage()
+{
+	const double Now = FPlatformTime::Seconds();
+	for (FPage& Page : Pages)
+	{
+		if (Page.Texture && Page.DirtyRect.Area() > 0 && Now - Page.LastPublished >= PublishIntervalSeconds)
+		{
+			PublishPage(Page);
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,459 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsThumbnailDiskCache.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/CityHash.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+FFastAssetsThumbnailDiskCache::FFastAssetsThumbnailDiskCache(const FString& InCacheDirectory, int64 InMaxCacheBytes)
+	: CacheDirectory(InCacheDirectory)
+	, MaxCacheBytes(InMaxCacheBytes)
+	, bReadOnly(false)
+	, WritePackIndex(0)
+	, WritePackSize(0)
+	, TotalBytes(0)
+	// Small budgets get small packs, so dropping one frees a fair share of the cache
+	, PackLimitBytes(FMath::Clamp(InMaxCacheBytes / 4, MinPackBytes, MaxPackBytes))
+{
+	Open();
+}
+
+FFastAssetsThumbnailDiskCache::~FFastAssetsThumbnailDiskCache()
+{
+	Flush();
+
+	FScopeLock Lock(&WriterLock);
+	WritePack.Reset();
+	IndexWriter.Reset();
+	LockFile.Reset();
+}
+
+FString FFastAssetsThumbnailDiskCache::GetDefaultCacheDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("FastAssets") / TEXT("ThumbnailCache");
+}
+
+uint64 FFastAssetsThumbnailDiskCache::MakeKey(const FString& FilePath, int64 FileSize, const FDateTime& ModifiedTime, int32 ThumbnailSize)
+{
+	FString NormalizedPath = FPaths::ConvertRelativePathToFull(FilePath).ToLower();
+	FPaths::NormalizeFilename(NormalizedPath);
+
+	struct FKeyData
+	{
+		uint64 PathHash;
+		int64 FileSize;
+		int64 Ticks;
+		int64 ThumbnailSize;
+	};
+
+	FKeyData KeyData;
+	KeyData.PathHash = CityHash64((const char*)*NormalizedPath, NormalizedPath.Len() * sizeof(TCHAR));
+	KeyData.FileSize = FileSize;
+	KeyData.Ticks = ModifiedTime.GetTicks();
+	KeyData.ThumbnailSize = ThumbnailSize;
+
+	return CityHash64((const char*)&KeyData, sizeof(KeyData));
+}
+
+FString FFastAssetsThumbnailDiskCache::GetPackPath(int32 PackIndex) const
+{
+	return CacheDirectory / FString::Printf(TEXT("Pack_%05d.bin"), PackIndex);
+}
+
+FString FFastAssetsThumbnailDiskCache::GetIndexPath() const
+{
+	return CacheDirectory / TEXT("Index.bin");
+}
+
+FString FFastAssetsThumbnailDiskCache::GetLockPath() const
+{
+	return CacheDirectory / TEXT("Writer.lock");
+}
+
+void FFastAssetsThumbnailDiskCache::Open()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*CacheDirectory);
+
+	// A second editor on the same project would append to the same packs and rewrite the index under
+	// the first, so only the process holding the lock file writes; the others read what is there
+	LockFile.Reset(PlatformFile.OpenWrite(*GetLockPath()));
+	bReadOnly = !LockFile.IsValid();
+
+	// Load the index: header followed by fixed-size entries, last write for a key wins
+	TArray<uint8> IndexData;
+	const bool bIndexLoaded = FFileHelper::LoadFileToArray(IndexData, *GetIndexPath(), FILEREAD_Silent);
+	if (bIndexLoaded)
+	{
+		const uint32* Header = (const uint32*)IndexData.GetData();
+		if (IndexData.Num() < 8 || Header[0] != IndexMagic || Header[1] != IndexVersion)
+		{
+			if (bReadOnly)
+			{
+				UE_LOG(LogTemp, Log, TEXT("FastAssets: Thumbnail disk cache has an old format and another editor owns it, not using it"));
+				return;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("FastAssets: Thumbnail disk cache has an old format, rebuilding"));
+			Reset();
+			return;
+		}
+
+		const int32 NumEntries = (IndexData.Num() - 8) / sizeof(FIndexEntry);
+		const FIndexEntry* Entries = (const FIndexEntry*)(IndexData.GetData() + 8);
+
+		Index.Reserve(NumEntries);
+		for (int32 EntryIndex = 0; EntryIndex < NumEntries; EntryIndex++)
+		{
+			Index.Add(Entries[EntryIndex].Key, Entries[EntryIndex]);
+		}
+	}
+
+	// Find the packs on disk, oldest first
+	TArray<FString> PackFiles;
+	IFileManager::Get().FindFiles(PackFiles, *(CacheDirectory / TEXT("Pack_*.bin")), true, false);
+	PackFiles.Sort();
+
+	for (const FString& PackFile : PackFiles)
+	{
+		const int32 PackIndex = FCString::Atoi(*FPaths::GetBaseFilename(PackFile).RightChop(5));
+		if (PackIndex >= MAX_uint16 - 1)
+		{
+			// Pack numbering ran out, start over; the owner of the cache does that
+			if (!bReadOnly)
+			{
+				Reset();
+			}
+			return;
+		}
+
+		const int64 PackSize = PlatformFile.FileSize(*GetPackPath(PackIndex));
+		PackIndices.Add((uint16)PackIndex);
+		PackSizes.Add((uint16)PackIndex, PackSize);
+		TotalBytes += PackSize;
+	}
+
+	const int32 NumIndexed = Index.Num();
+
+	// Drop whole packs, oldest first, until the cache fits its budget
+	while (!bReadOnly && PackIndices.Num() > 0 && TotalBytes > MaxCacheBytes)
+	{
+		EvictOldestPack();
+	}
+
+	// Remove index entries whose data is gone or was never fully written
+	for (auto It = Index.CreateIterator(); It; ++It)
+	{
+		const int64* PackSize = PackSizes.Find(It.Value().Pack);
+		if (!PackSize || (int64)It.Value().Offset + sizeof(FRecordHeader) + It.Value().CompressedSize > *PackSize)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Map the surviving packs; they are never written again
+	for (uint16 PackIndex : PackIndices)
+	{
+		MapPack(PackIndex);
+	}
+
+	WritePackIndex = PackIndices.Num() > 0 ? (uint16)(PackIndices.Last() + 1) : 0;
+
+	// A fresh index needs its header before entries are appended to it
+	if (!bReadOnly && (!bIndexLoaded || Index.Num() != NumIndexed))
+	{
+		WriteIndex();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FastAssets: Thumbnail disk cache opened%s with %d entries in %d packs (%.1f MB)"),
+		bReadOnly ? TEXT(" read-only, another editor owns it,") : TEXT(""), Index.Num(), MappedPacks.Num(), TotalBytes / (1024.0 * 1024.0));
+}
+
+void FFastAssetsThumbnailDiskCache::Reset()
+{
+	// The lock file goes with the directory, so it is let go and taken again around the delete
+	LockFile.Reset();
+	IFileManager::Get().DeleteDirectory(*CacheDirectory, false, true);
+	IFileManager::Get().MakeDirectory(*CacheDirectory, true);
+	LockFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*GetLockPath()));
+	bReadOnly = !LockFile.IsValid();
+
+	Index.Empty();
+	MappedPacks.Empty();
+	PackIndices.Empty();
+	PackSizes.Empty();
+	TotalBytes = 0;
+	WritePackIndex = 0;
+	if (!bReadOnly)
+	{
+		WriteIndex();
+	}
+}
+
+void FFastAssetsThumbnailDiskCache::WriteIndex()
+{
+	TArray<uint8> IndexData;
+	IndexData.SetNumUninitialized(8 + Index.Num() * sizeof(FIndexEntry));
+
+	uint32* Header = (uint32*)IndexData.GetData();
+	Header[0] = IndexMagic;
+	Header[1] = IndexVersion;
+
+	FIndexEntry* Entries = (FIndexEntry*)(IndexData.GetData() + 8);
+	for (const TPair<uint64, FIndexEntry>& Pair : Index)
+	{
+		*Entries++ = Pair.Value;
+	}
+
+	FFileHelper::SaveArrayToFile(IndexData, *GetIndexPath());
+}
+
+bool FFastAssetsThumbnailDiskCache::OpenWritePack()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!WritePack.IsValid())
+	{
+		// Read access lets entries written this session be loaded back through the same handle
+		WritePack.Reset(PlatformFile.OpenWrite(*GetPackPath(WritePackIndex), false, true));
+		WritePackSize = 0;
+
+		if (WritePack.IsValid() && !PackSizes.Contains(WritePackIndex))
+		{
+			PackIndices.Add(WritePackIndex);
+			PackSizes.Add(WritePackIndex, 0);
+		}
+	}
+
+	if (!IndexWriter.IsValid())
+	{
+		IndexWriter.Reset(PlatformFile.OpenWrite(*GetIndexPath(), true, false));
+	}
+
+	return WritePack.IsValid() && IndexWriter.IsValid();
+}
+
+void FFastAssetsThumbnailDiskCache::MapPack(uint16 PackIndex)
+{
+	FOpenMappedResult MappedResult = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*GetPackPath(PackIndex));
+	if (MappedResult.HasError())
+	{
+		return;
+	}
+
+	FMappedPack Pack;
+	Pack.Handle = MappedResult.StealValue();
+	Pack.Region.Reset(Pack.Handle->MapRegion());
+	if (Pack.Region.IsValid())
+	{
+		Pack.Data = Pack.Region->GetMappedPtr();
+		Pack.Size = Pack.Region->GetMappedSize();
+
+		FWriteScopeLock Lock(PacksLock);
+		MappedPacks.Add(PackIndex, MoveTemp(Pack));
+	}
+}
+
+void FFastAssetsThumbnailDiskCache::EvictOldestPack()
+{
+	const uint16 OldestPack = PackIndices[0];
+	PackIndices.RemoveAt(0);
+	TotalBytes -= PackSizes.FindAndRemoveChecked(OldestPack);
+
+	{
+		// Readers copy out of the mapping under the read lock, so it is safe to unmap here
+		FWriteScopeLock Lock(PacksLock);
+		MappedPacks.Remove(OldestPack);
+	}
+
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*GetPackPath(OldestPack));
+
+	FWriteScopeLock Lock(IndexLock);
+	for (auto It = Index.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Pack == OldestPack)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FFastAssetsThumbnailDiskCache::Contains(uint64 Key) const
+{
+	FReadScopeLock Lock(IndexLock);
+	return Index.Contains(Key);
+}
+
+bool FFastAssetsThumbnailDiskCache::ReadRecord(const FIndexEntry& Entry, TArray<uint8>& OutRecord) const
+{
+	const int64 RecordSize = sizeof(FRecordHeader) + Entry.CompressedSize;
+
+	auto ReadMappedRecord = [this, &Entry, &OutRecord, RecordSize]()
+	{
+		FReadScopeLock Lock(PacksLock);
+		const FMappedPack* Pack = MappedPacks.Find(Entry.Pack);
+		if (!Pack || (int64)Entry.Offset + RecordSize > Pack->Size)
+		{
+			return false;
+		}
+
+		OutRecord.SetNumUninitialized(RecordSize);
+		FMemory::Memcpy(OutRecord.GetData(), Pack->Data + Entry.Offset, RecordSize);
+		return true;
+	};
+
+	if (ReadMappedRecord())
+	{
+		return true;
+	}
+
+	// Written this session, read back through the append handle
+	FScopeLock Lock(&WriterLock);
+	if (Entry.Pack != WritePackIndex || !WritePack.IsValid())
+	{
+		// The pack may have been sealed and mapped since the first look
+		return ReadMappedRecord();
+	}
+
+	OutRecord.SetNumUninitialized(RecordSize);
+	const bool bRead = WritePack->Seek(Entry.Offset) && WritePack->Read(OutRecord.GetData(), RecordSize);
+	WritePack->SeekFromEnd(0);
+	return bRead;
+}
+
+bool FFastAssetsThumbnailDiskCache::Load(uint64 Key, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels) const
+{
+	FIndexEntry Entry;
+	{
+		FReadScopeLock Lock(IndexLock);
+		const FIndexEntry* Found = Index.Find(Key);
+		if (!Found)
+		{
+			return false;
+		}
+		Entry = *Found;
+	}
+
+	TArray<uint8> Record;
+	if (!ReadRecord(Entry, Record))
+	{
+		return false;
+	}
+
+	// The record header must agree with the index, otherwise the pack was truncated or overwritten
+	const FRecordHeader* Header = (const FRecordHeader*)Record.GetData();
+	if (Header->Key != Key || Header->CompressedSize != Entry.CompressedSize || Header->Width != Entry.Width || Header->Height != Entry.Height)
+	{
+		return false;
+	}
+
+	const int32 RawSize = Entry.Width * Entry.Height * 4;
+	OutPixels.SetNumUninitialized(RawSize);
+	if (!FCompression::UncompressMemory(NAME_LZ4, OutPixels.GetData(), RawSize, Record.GetData() + sizeof(FRecordHeader), Entry.CompressedSize))
+	{
+		OutPixels.Empty();
+		return false;
+	}
+
+	OutWidth = Entry.Width;
+	OutHeight = Entry.Height;
+	return true;
+}
+
+void FFastAssetsThumbnailDiskCache::Store(uint64 Key, int32 Width, int32 Height, const TArray<uint8>& Pixels)
+{
+	if (bReadOnly || Width <= 0 || Height <= 0 || Width > MAX_uint16 || Height > MAX_uint16 || Pixels.Num() != Width * Height * 4)
+	{
+		return;
+	}
+
+	// Compress outside the lock
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, Pixels.Num());
+	TArray<uint8> Record;
+	Record.SetNumUninitialized(sizeof(FRecordHeader) + CompressedSize);
+	if (!FCompression::CompressMemory(NAME_LZ4, Record.GetData() + sizeof(FRecordHeader), CompressedSize, Pixels.GetData(), Pixels.Num()))
+	{
+		return;
+	}
+	Record.SetNum(sizeof(FRecordHeader) + CompressedSize);
+
+	FRecordHeader* Header = (FRecordHeader*)Record.GetData();
+	Header->Key = Key;
+	Header->CompressedSize = CompressedSize;
+	Header->Width = (uint16)Width;
+	Header->Height = (uint16)Height;
+
+	FIndexEntry Entry;
+	{
+		FScopeLock Lock(&WriterLock);
+
+		if (WritePack.IsValid() && WritePackSize + Record.Num() > PackLimitBytes)
+		{
+			// Seal the full pack and map it, so its entries stay readable
+			WritePack.Reset();
+			MapPack(WritePackIndex);
+			WritePackIndex++;
+		}
+
+		// Make room by dropping the oldest packs; the pack being written is never dropped
+		bool bEvicted = false;
+		while (TotalBytes + Record.Num() > MaxCacheBytes && PackIndices.Num() > 0 && PackIndices[0] != WritePackIndex)
+		{
+			EvictOldestPack();
+			bEvicted = true;
+		}
+
+		if (bEvicted)
+		{
+			// Start a fresh index without the dropped entries, the appender reopens below
+			IndexWriter.Reset();
+			WriteIndex();
+		}
+
+		if (!OpenWritePack())
+		{
+			return;
+		}
+
+		Entry.Key = Key;
+		Entry.Offset = (uint32)WritePackSize;
+		Entry.CompressedSize = CompressedSize;
+		Entry.Pack = WritePackIndex;
+		Entry.Width = (uint16)Width;
+		Entry.Height = (uint16)Height;
+
+		// Data first, then the index entry, so a crash never leaves an entry pointing at missing data
+		if (!WritePack->Write(Record.GetData(), Record.Num()))
+		{
+			return;
+		}
+		WritePackSize += Record.Num();
+		PackSizes[WritePackIndex] += Record.Num();
+		TotalBytes += Record.Num();
+		IndexWriter->Write((const uint8*)&Entry, sizeof(Entry));
+
+		// Added before the writer lock is released, so an index rewrite never misses it
+		FWriteScopeLock IndexWriteLock(IndexLock);
+		Index.Add(Key, Entry);
+	}
+}
+
+void FFastAssetsThumbnailDiskCache::Flush()
+{
+	FScopeLock Lock(&WriterLock);
+
+	if (WritePack.IsValid())
+	{
+		WritePack->Flush();
+	}
+
+	if (IndexWriter.IsValid())
+	{
+		IndexWriter->Flush();
+	}
+}
@@ -0,0 +1,135 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsThumbnailScheduler.h"
+#include "CoreGlobals.h"
+
+FFastAssetsThumbnailScheduler::FFastAssetsThumbnailScheduler(int32 InMaxInFlight)
+	: MaxInFlight(FMath::Max(1, InMaxInFlight))
+{
+}
+
+bool FFastAssetsThumbnailScheduler::IsStale(EFastAssetsThumbnailPriority Priority, uint64 LastRequestedFrame)
+{
+	return Priority != EFastAssetsThumbnailPriority::Background && LastRequestedFrame + StaleFrames < GFrameCounter;
+}
+
+void FFastAssetsThumbnailScheduler::Request(const FString& FilePath, EFastAssetsThumbnailPriority Priority)
+{
+	if (FInFlightJob* Job = InFlight.Find(FilePath))
+	{
+		Job->Priority = FMath::Min(Job->Priority, Priority);
+		Job->LastRequestedFrame = GFrameCounter;
+		return;
+	}
+
+	FQueuedRequest* Existing = Queued.Find(FilePath);
+	if (Existing && Existing->Priority <= Priority)
+	{
+		Existing->LastRequestedFrame = GFrameCounter;
+		return;
+	}
+
+	FQueuedRequest& Request = Existing ? *Existing : Queued.Add(FilePath);
+	Request.Priority = Priority;
+	Request.LastRequestedFrame = GFrameCounter;
+	Order[(int32)Priority].Add(FilePath);
+}
+
+bool FFastAssetsThumbnailScheduler::IsRequested(const FString& FilePath) const
+{
+	return Queued.Contains(FilePath) || InFlight.Contains(FilePath);
+}
+
+void FFastAssetsThumbnailScheduler::Update(TFunctionRef<void(const FString&, const FFastAssetsCancelFlag&)> StartJob, TFunctionRef<void(const FString&)> OnCancelled)
+{
+	// Started jobs whose tiles went away stop at their next checkpoint
+	int32 NumBackgroundInFlight = 0;
+	for (TPair<FString, FInFlightJob>& Pair : InFlight)
+	{
+		if (IsStale(Pair.Value.Priority, Pair.Value.LastRequestedFrame))
+		{
+			*Pair.Value.CancelFlag = true;
+		}
+
+		if (Pair.Value.Priority == EFastAssetsThumbnailPriority::Background)
+		{
+			NumBackgroundInFlight++;
+		}
+	}
+
+	for (int32 PriorityIndex = 0; PriorityIndex < UE_ARRAY_COUNT(Order); PriorityIndex++)
+	{
+		TArray<FString>& PriorityOrder = Order[PriorityIndex];
+
+		// Background work leaves a worker free for whatever a window asks for next
+		const bool bBackground = PriorityIndex == (int32)EFastAssetsThumbnailPriority::Background;
+		const int32 Limit = bBackground ? FMath::Max(MaxInFlight - 1, 1) : MaxInFlight;
+
+		// Newest first: after a fast scroll the tiles on screen now matter more than older ones
+		while (PriorityOrder.Num() > 0 && InFlight.Num() < Limit && (!bBackground || NumBackgroundInFlight < MaxBackgroundInFlight))
+		{
+			const FString FilePath = PriorityOrder.Pop(EAllowShrinking::No);
+
+			const FQueuedRequest* Request = Queued.Find(FilePath);
+			if (!Request || (int32)Request->Priority != PriorityIndex)
+			{
+				// Dropped already, or moved to another priority
+				continue;
+			}
+
+			if (IsStale(Request->Priority, Request->LastRequestedFrame))
+			{
+				Queued.Remove(FilePath);
+				OnCancelled(FilePath);
+				continue;
+			}
+
+			FFastAssetsCancelFlag CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+			InFlight.Add(FilePath, FInFlightJob(CancelFlag, *Request));
+			Queued.Remove(FilePath);
+			NumBackgroundInFlight += bBackground ? 1 : 0;
+
+			StartJob(FilePath, CancelFlag);
+		}
+
+		// Drop stale entries left behind in this priority even when no worker is free
+		if (!bBackground)
+		{
+			for (int32 Index = PriorityOrder.Num() - 1; Index >= 0; Index--)
+			{
+				const FQueuedRequest* Request = Queued.Find(PriorityOrder[Index]);
+				if (Request && (int32)Request->Priority == PriorityIndex && !IsStale(Request->Priority, Request->LastRequestedFrame))
+				{
+					continue;
+				}
+
+				if (Request && (int32)Request->Priority == PriorityIndex)
+				{
+					const FString FilePath = PriorityOrder[Index];
+					Queued.Remove(FilePath);
+					OnCancelled(FilePath);
+				}
+				PriorityOrder.RemoveAt(Index, EAllowShrinking::No);
+			}
+		}
+	}
+}
+
+void FFastAssetsThumbnailScheduler::OnJobFinished(const FString& FilePath)
+{
+	InFlight.Remove(FilePath);
+}
+
+void FFastAssetsThumbnailScheduler::CancelAll()
+{
+	for (TPair<FString, FInFlightJob>& Pair : InFlight)
+	{
+		*Pair.Value.CancelFlag = true;
+	}
+
+	Queued.Empty();
+	for (TArray<FString>& PriorityOrder : Order)
+	{
+		PriorityOrder.Empty();
+	}
+}
@@ -0,0 +1,80 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsThumbnailWorkerCommandlet.h"
+#include "FastAssetsWorkerProcessPool.h"
+#include "FastAssetsThumbnail.h"
+#include "Misc/Parse.h"
+#include <stdio.h>
+
+namespace
+{
+	/** Answer the editor on stdout, flushed so it is not held back behind buffered output */
+	void WriteReply(const FString& Line)
+	{
+		fputs(TCHAR_TO_UTF8(*(Line + TEXT("\n"))), stdout);
+		fflush(stdout);
+	}
+}
+
+UFastAssetsThumbnailWorkerCommandlet::UFastAssetsThumbnailWorkerCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = false;
+	ShowErrorCount = false;
+}
+
+int32 UFastAssetsThumbnailWorkerCommandlet::Main(const FString& Params)
+{
+	FString SharedMemoryName;
+	int32 MaxSize = 0;
+	if (!FParse::Value(*Params, TEXT("SharedMemory="), SharedMemoryName) || !FParse::Value(*Params, TEXT("MaxSize="), MaxSize) || MaxSize <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FastAssets: Thumbnail worker needs -SharedMemory= and -MaxSize="));
+		return 1;
+	}
+
+	const int64 RegionSize = FFastAssetsWorkerProcessPool::GetSharedMemorySize(MaxSize);
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(SharedMemoryName, false,
+		static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write),
+		RegionSize);
+	if (!Region)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FastAssets: Thumbnail worker could not open shared memory %s"), *SharedMemoryName);
+		return 1;
+	}
+
+	WriteReply(FFastAssetsWorkerProcessPool::ReadyMarker);
+
+	// One file per line until the editor closes the pipe
+	char LineBuffer[4096];
+	while (fgets(LineBuffer, sizeof(LineBuffer), stdin))
+	{
+		FString FilePath = UTF8_TO_TCHAR(LineBuffer);
+		FilePath.TrimEndInline();
+		if (FilePath.IsEmpty())
+		{
+			continue;
+		}
+
+		FFastAssetsDecodedThumbnail Decoded;
+		const bool bDecoded = FFastAssetsThumbnail::DecodeStandalone(FilePath, MaxSize, Decoded)
+			&& Decoded.Width > 0 && Decoded.Height > 0
+			&& Decoded.Pixels.Num() == Decoded.Width * Decoded.Height * 4
+			&& Decoded.Pixels.Num() <= RegionSize;
+
+		if (bDecoded)
+		{
+			FMemory::Memcpy(Region->GetAddress(), Decoded.Pixels.GetData(), Decoded.Pixels.Num());
+			WriteReply(FString::Printf(TEXT("%s OK %d %d"), FFastAssetsWorkerProcessPool::ResultMarker, Decoded.Width, Decoded.Height));
+		}
+		else
+		{
+			WriteReply(FString::Printf(TEXT("%s FAIL"), FFastAssetsWorkerProcessPool::ResultMarker));
+		}
+	}
+
+	FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+	return 0;
+}
@@ -0,0 +1,151 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsUpdateApplier.h"
+#include "FastAssetsSettings.h"
+#include "FastAssetsStats.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("Apply Updates"), STAT_FastAssetsApplyUpdates, STATGROUP_FastAssets);
+DECLARE_CYCLE_STAT(TEXT("Apply Refreshes"), STAT_FastAssetsApplyRefreshes, STATGROUP_FastAssets);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Updates Applied"), STAT_FastAssetsUpdatesApplied, STATGROUP_FastAssets);
+
+TSharedPtr<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> FFastAssetsUpdateApplier::Instance = nullptr;
+
+FFastAssetsUpdateApplier::FFastAssetsUpdateApplier()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFastAssetsUpdateApplier::Tick));
+}
+
+FFastAssetsUpdateApplier::~FFastAssetsUpdateApplier()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+	}
+}
+
+FFastAssetsUpdateApplier& FFastAssetsUpdateApplier::Get()
+{
+	if (!Instance.IsValid())
+	{
+		// Registers a ticker, so the first call must come from the game thread
+		check(IsInGameThread());
+		Instance = MakeShared<FFastAssetsUpdateApplier, ESPMode::ThreadSafe>();
+	}
+	return *Instance;
+}
+
+TSharedRef<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> FFastAssetsUpdateApplier::GetShared()
+{
+	Get();
+	return Instance.ToSharedRef();
+}
+
+void FFastAssetsUpdateApplier::Shutdown()
+{
+	if (!Instance.IsValid())
+	{
+		return;
+	}
+
+	// Scans still running hold their own reference and may enqueue into it; the ticker goes now,
+	// so nothing they send is applied, and the queue is freed with the last reference
+	FTSTicker::GetCoreTicker().RemoveTicker(Instance->TickerHandle);
+	Instance->TickerHandle.Reset();
+	Instance.Reset();
+}
+
+void FFastAssetsUpdateApplier::EnqueueUpdate(TUniqueFunction<void()>&& Update)
+{
+	Updates.Enqueue(MoveTemp(Update));
+}
+
+FDelegateHandle FFastAssetsUpdateApplier::AddSource(FApplyNext&& Source)
+{
+	check(IsInGameThread());
+
+	const FDelegateHandle Handle = Source.GetHandle();
+	Sources.Add(MoveTemp(Source));
+	return Handle;
+}
+
+void FFastAssetsUpdateApplier::RemoveSource(FDelegateHandle Handle)
+{
+	check(IsInGameThread());
+	Sources.RemoveAll([Handle](const FApplyNext& Source) { return Source.GetHandle() == Handle; });
+}
+
+void FFastAssetsUpdateApplier::RequestRefresh(const void* Key, TUniqueFunction<void()>&& Refresh)
+{
+	check(IsInGameThread());
+	PendingRefreshes.Add(Key, MoveTemp(Refresh));
+}
+
+void FFastAssetsUpdateApplier::CancelRefresh(const void* Key)
+{
+	PendingRefreshes.Remove(Key);
+}
+
+bool FFastAssetsUpdateApplier::ApplyNextUpdate()
+{
+	TUniqueFunction<void()> Update;
+	if (!Updates.Dequeue(Update))
+	{
+		return false;
+	}
+
+	Update();
+	return true;
+}
+
+bool FFastAssetsUpdateApplier::Tick(float DeltaTime)
+{
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastAssetsApplyUpdates);
+
+		const double Deadline = FPlatformTime::Seconds() + UFastAssetsSettings::Get()->GetMainThreadBudgetSeconds();
+
+		// Give the queued updates and every source one turn per pass. The first pass always runs,
+		// so a tiny budget still makes progress.
+		bool bAnyApplied = true;
+		for (int32 Pass = 0; bAnyApplied && (Pass == 0 || FPlatformTime::Seconds() < Deadline); Pass++)
+		{
+			bAnyApplied = false;
+			if (ApplyNextUpdate())
+			{
+				INC_DWORD_STAT(STAT_FastAssetsUpdatesApplied);
+				bAnyApplied = true;
+			}
+
+			const int32 NumSources = Sources.Num();
+			for (int32 Turn = 0; Turn < NumSources && Sources.Num() > 0; Turn++)
+			{
+				FApplyNext& Source = Sources[(FirstSource + Turn) % Sources.Num()];
+				if (Source.Execute())
+				{
+					INC_DWORD_STAT(STAT_FastAssetsUpdatesApplied);
+					bAnyApplied = true;
+				}
+			}
+		}
+
+		FirstSource = Sources.Num() > 0 ? (FirstSource + 1) % Sources.Num() : 0;
+	}
+
+	// Refreshes run once per frame however many updates asked for them. They are not cut by the
+	// budget; one list refresh is the cost the budget leaves room for.
+	if (PendingRefreshes.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FastAssetsApplyRefreshes);
+
+		TMap<const void*, TUniqueFunction<void()>> Refreshes = MoveTemp(PendingRefreshes);
+		PendingRefreshes.Reset();
+
+		for (TPair<const void*, TUniqueFunction<void()>>& Refresh : Refreshes)
+		{
+			Refresh.Value();
+		}
+	}
+
+	return true;
+}
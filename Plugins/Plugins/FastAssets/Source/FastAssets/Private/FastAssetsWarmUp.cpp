@@ -0,0 +1,142 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsWarmUp.h"
+#include "FastAssetsSharedCatalog.h"
+#include "FastAssetsCatalog.h"
+#include "FastAssetsSettings.h"
+#include "FastAssetsThumbnail.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+
+FFastAssetsWarmUp::~FFastAssetsWarmUp()
+{
+	FCoreDelegates::OnFEngineLoopInitComplete.Remove(EngineInitHandle);
+	FTSTicker::GetCoreTicker().RemoveTicker(DelayHandle);
+
+	if (CurrentCatalog.IsValid())
+	{
+		CurrentCatalog->OnChanged().Remove(CatalogChangedHandle);
+	}
+}
+
+void FFastAssetsWarmUp::Start()
+{
+	const UFastAssetsSettings* Settings = UFastAssetsSettings::Get();
+	for (int32 Index = 0; Index < Settings->RecentPaths.Num() && PendingPaths.Num() < Settings->WarmUpRecentPathsCount; Index++)
+	{
+		PendingPaths.Add(Settings->RecentPaths[Index]);
+	}
+
+	if (PendingPaths.Num() == 0)
+	{
+		return;
+	}
+
+	// Editor boot is left alone; the delay starts once the engine loop is up
+	if (GIsRunning)
+	{
+		OnEngineInitComplete();
+	}
+	else
+	{
+		EngineInitHandle = FCoreDelegates::OnFEngineLoopInitComplete.AddRaw(this, &FFastAssetsWarmUp::OnEngineInitComplete);
+	}
+}
+
+void FFastAssetsWarmUp::OnEngineInitComplete()
+{
+	FCoreDelegates::OnFEngineLoopInitComplete.Remove(EngineInitHandle);
+	DelayHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFastAssetsWarmUp::OnStartDelayElapsed), StartDelaySeconds);
+}
+
+bool FFastAssetsWarmUp::OnStartDelayElapsed(float DeltaTime)
+{
+	DelayHandle.Reset();
+	WarmUpNextPath();
+	return false;
+}
+
+void FFastAssetsWarmUp::WarmUpNextPath()
+{
+	while (PendingPaths.Num() > 0)
+	{
+		const FString Path = PendingPaths[0];
+		PendingPaths.RemoveAt(0);
+
+		// Recent paths outlive the folders they name
+		if (!FPaths::DirectoryExists(Path))
+		{
+			UE_LOG(LogTemp, Log, TEXT("FastAssets: Skipping warm-up of missing folder %s"), *Path);
+			continue;
+		}
+
+		TSharedRef<FFastAssetsSharedCatalog> Catalog = FFastAssetsSharedCatalog::Get(Path);
+		WarmCatalogs.AddUnique(Catalog);
+
+		CurrentCatalog = Catalog;
+		CurrentStartTime = FPlatformTime::Seconds();
+		CatalogChangedHandle = Catalog->OnChanged().AddRaw(this, &FFastAssetsWarmUp::OnCatalogChanged);
+
+		// A window may have scanned it already
+		Catalog->EnsureScanned();
+		if (!Catalog->IsScanning())
+		{
+			FinishCurrentPath();
+		}
+		return;
+	}
+}
+
+void FFastAssetsWarmUp::OnCatalogChanged(int32 FirstAddedIndex)
+{
+	if (CurrentCatalog.IsValid() && !CurrentCatalog->IsScanning())
+	{
+		FinishCurrentPath();
+	}
+}
+
+void FFastAssetsWarmUp::FinishCurrentPath()
+{
+	CurrentCatalog->OnChanged().Remove(CatalogChangedHandle);
+	QueueThumbnails(*CurrentCatalog);
+
+	const TSharedPtr<FFastAssetsCatalog> DiskCatalog = CurrentCatalog->GetDiskCatalog();
+	UE_LOG(LogTemp, Log, TEXT("FastAssets: Warmed up %s (%d assets) in %.2f s"), *CurrentCatalog->GetRootPath(),
+		DiskCatalog.IsValid() ? DiskCatalog->Num() : CurrentCatalog->GetAssets().Num(), FPlatformTime::Seconds() - CurrentStartTime);
+	CurrentCatalog.Reset();
+
+	// One folder at a time, with a pause between them
+	if (PendingPaths.Num() > 0)
+	{
+		DelayHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFastAssetsWarmUp::OnStartDelayElapsed), PathDelaySeconds);
+	}
+}
+
+void FFastAssetsWarmUp::QueueThumbnails(const FFastAssetsSharedCatalog& Catalog)
+{
+	TArray<FString> FilePaths;
+	TArray<FString> AssetTypes;
+
+	// The assets a window shows first, before any search or folder filter
+	if (const TSharedPtr<FFastAssetsCatalog> DiskCatalog = Catalog.GetDiskCatalog())
+	{
+		for (int32 Index = 0; Index < DiskCatalog->Num() && Index < ThumbnailsPerPath; Index++)
+		{
+			const FFastAssetsCatalog::FRecord& Record = DiskCatalog->GetRecord(Index);
+			FilePaths.Add(FString(DiskCatalog->GetPath(Record)));
+			AssetTypes.Add(FFastAssetsSharedCatalog::DetermineAssetType(FFastAssetsSharedCatalog::GetSupportedExtensions()[Record.TypeIndex]));
+		}
+	}
+	else
+	{
+		const TArray<TSharedPtr<FExternalAssetItem>>& Assets = Catalog.GetAssets();
+		for (int32 Index = 0; Index < Assets.Num() && Index < ThumbnailsPerPath; Index++)
+		{
+			FilePaths.Add(Assets[Index]->FilePath);
+			AssetTypes.Add(Assets[Index]->AssetType);
+		}
+	}
+
+	// Queued at background priority: decoded one at a time, never ahead of what a window is showing
+	FFastAssetsThumbnail::Get().PreCacheThumbnails(FilePaths, AssetTypes);
+}
@@ -0,0 +1,248 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsWorkerProcessPool.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Event.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeExit.h"
+
+FFastAssetsWorkerProcessPool::FFastAssetsWorkerProcessPool(int32 NumWorkers, int32 InMaxSize)
+	: WorkerReleased(FPlatformProcess::GetSynchEventFromPool(false))
+	, MaxSize(InMaxSize)
+{
+	for (int32 WorkerIndex = 0; WorkerIndex < NumWorkers; WorkerIndex++)
+	{
+		Workers.Add(MakeUnique<FWorker>());
+		IdleWorkers.Add(WorkerIndex);
+
+		// Boot now so the helpers are up by the time the first thumbnails are wanted
+		LaunchWorker(WorkerIndex);
+	}
+}
+
+FFastAssetsWorkerProcessPool::~FFastAssetsWorkerProcessPool()
+{
+	for (const TUniquePtr<FWorker>& Worker : Workers)
+	{
+		StopWorker(*Worker);
+	}
+
+	FPlatformProcess::ReturnSynchEventToPool(WorkerReleased);
+}
+
+bool FFastAssetsWorkerProcessPool::LaunchWorker(int32 WorkerIndex)
+{
+	FWorker& Worker = *Workers[WorkerIndex];
+
+	const FString SharedMemoryName = FString::Printf(TEXT("FastAssetsThumbnails_%u_%d_%d"), FPlatformProcess::GetCurrentProcessId(), WorkerIndex, Worker.Generation++);
+	Worker.SharedMemory = FPlatformMemory::MapNamedSharedMemoryRegion(SharedMemoryName, true,
+		static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write),
+		GetSharedMemorySize(MaxSize));
+
+	if (!Worker.SharedMemory ||
+		!FPlatformProcess::CreatePipe(Worker.StdinRead, Worker.StdinWrite, true) ||
+		!FPlatformProcess::CreatePipe(Worker.StdoutRead, Worker.StdoutWrite))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to set up thumbnail helper process %d"), WorkerIndex);
+		StopWorker(Worker);
+		Worker.FailedLaunches++;
+		return false;
+	}
+
+	const FString Params = FString::Printf(TEXT("\"%s\" -run=%s -SharedMemory=%s -MaxSize=%d -nullrhi -nosplash -nosound -unattended -nopause"),
+		*FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), CommandletName, *SharedMemoryName, MaxSize);
+
+	// Below normal priority, so helpers never compete with the editor's own frame
+	Worker.Process = FPlatformProcess::CreateProc(*FPlatformProcess::ExecutablePath(), *Params, false, true, true, nullptr, -1, nullptr, Worker.StdoutWrite, Worker.StdinRead);
+	if (!Worker.Process.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Failed to start thumbnail helper process %d"), WorkerIndex);
+		StopWorker(Worker);
+		Worker.FailedLaunches++;
+		return false;
+	}
+
+	return true;
+}
+
+bool FFastAssetsWorkerProcessPool::WaitUntilReady(FWorker& Worker)
+{
+	FString Line;
+	if (!ReadMarkedLine(Worker, ReadyMarker, StartupTimeoutSeconds, Line))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Thumbnail helper process did not start"));
+		StopWorker(Worker);
+		Worker.FailedLaunches++;
+		return false;
+	}
+
+	Worker.bReady = true;
+	Worker.FailedLaunches = 0;
+	return true;
+}
+
+void FFastAssetsWorkerProcessPool::StopWorker(FWorker& Worker)
+{
+	// Closing stdin ends the helper's request loop; anything still running after that is killed
+	FPlatformProcess::ClosePipe(Worker.StdinRead, Worker.StdinWrite);
+	Worker.StdinRead = Worker.StdinWrite = nullptr;
+
+	if (Worker.Process.IsValid())
+	{
+		if (FPlatformProcess::IsProcRunning(Worker.Process))
+		{
+			FPlatformProcess::TerminateProc(Worker.Process, true);
+		}
+		FPlatformProcess::CloseProc(Worker.Process);
+	}
+
+	FPlatformProcess::ClosePipe(Worker.StdoutRead, Worker.StdoutWrite);
+	Worker.StdoutRead = Worker.StdoutWrite = nullptr;
+
+	if (Worker.SharedMemory)
+	{
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(Worker.SharedMemory);
+		Worker.SharedMemory = nullptr;
+	}
+
+	Worker.Output.Empty();
+	Worker.bReady = false;
+}
+
+bool FFastAssetsWorkerProcessPool::ReadMarkedLine(FWorker& Worker, const TCHAR* Marker, double TimeoutSeconds, FString& OutLine)
+{
+	const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+	while (true)
+	{
+		const bool bRunning = FPlatformProcess::IsProcRunning(Worker.Process);
+		Worker.Output += FPlatformProcess::ReadPipe(Worker.StdoutRead);
+
+		// The helper's log shares the pipe, so only lines starting with the marker are answers
+		int32 LineEnd = INDEX_NONE;
+		while (Worker.Output.FindChar(TEXT('\n'), LineEnd))
+		{
+			FString Line = Worker.Output.Left(LineEnd).TrimEnd();
+			Worker.Output.RightChopInline(LineEnd + 1);
+
+			if (Line.StartsWith(Marker))
+			{
+				OutLine = MoveTemp(Line);
+				return true;
+			}
+		}
+
+		// Checked before the read above, so output written just before exiting is not lost
+		if (!bRunning || FPlatformTime::Seconds() > Deadline)
+		{
+			return false;
+		}
+
+		FPlatformProcess::Sleep(0.002f);
+	}
+}
+
+int32 FFastAssetsWorkerProcessPool::AcquireWorker(const std::atomic<bool>& CancelFlag)
+{
+	while (!CancelFlag)
+	{
+		{
+			FScopeLock Lock(&IdleLock);
+
+			bool bAnyUsable = false;
+			for (const TUniquePtr<FWorker>& Worker : Workers)
+			{
+				bAnyUsable |= IsUsable(*Worker);
+			}
+			if (!bAnyUsable)
+			{
+				return INDEX_NONE;
+			}
+
+			for (int32 Index = 0; Index < IdleWorkers.Num(); Index++)
+			{
+				if (IsUsable(*Workers[IdleWorkers[Index]]))
+				{
+					const int32 WorkerIndex = IdleWorkers[Index];
+					IdleWorkers.RemoveAtSwap(Index);
+					return WorkerIndex;
+				}
+			}
+		}
+
+		// Woken by a release; the timeout keeps the cancel flag checked
+		WorkerReleased->Wait(20);
+	}
+	return INDEX_NONE;
+}
+
+void FFastAssetsWorkerProcessPool::ReleaseWorker(int32 WorkerIndex)
+{
+	{
+		FScopeLock Lock(&IdleLock);
+		IdleWorkers.Add(WorkerIndex);
+	}
+	WorkerReleased->Trigger();
+}
+
+FFastAssetsWorkerProcessPool::EResult FFastAssetsWorkerProcessPool::Decode(const FString& FilePath, const std::atomic<bool>& CancelFlag, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight)
+{
+	const int32 WorkerIndex = AcquireWorker(CancelFlag);
+	if (WorkerIndex == INDEX_NONE)
+	{
+		return CancelFlag ? EResult::Failed : EResult::Unavailable;
+	}
+
+	FWorker& Worker = *Workers[WorkerIndex];
+	ON_SCOPE_EXIT
+	{
+		ReleaseWorker(WorkerIndex);
+	};
+
+	// Relaunch a helper that crashed on an earlier file
+	if (!Worker.bReady && !Worker.Process.IsValid() && !LaunchWorker(WorkerIndex))
+	{
+		return EResult::Unavailable;
+	}
+	if (!Worker.bReady && !WaitUntilReady(Worker))
+	{
+		return EResult::Unavailable;
+	}
+
+	// Send the path as UTF-8; one request per line
+	FTCHARToUTF8 Utf8Path(*FilePath);
+	TArray<uint8> Request;
+	Request.Append(reinterpret_cast<const uint8*>(Utf8Path.Get()), Utf8Path.Length());
+	Request.Add('\n');
+
+	FString Line;
+	if (!FPlatformProcess::WritePipe(Worker.StdinWrite, Request.GetData(), Request.Num()) ||
+		!ReadMarkedLine(Worker, ResultMarker, DecodeTimeoutSeconds, Line))
+	{
+		// The file crashed or hung the helper; only the helper pays for it
+		UE_LOG(LogTemp, Warning, TEXT("FastAssets: Thumbnail helper process stopped while decoding: %s"), *FilePath);
+		StopWorker(Worker);
+		return EResult::Failed;
+	}
+
+	TArray<FString> Tokens;
+	Line.ParseIntoArrayWS(Tokens);
+	if (Tokens.Num() != 4 || Tokens[1] != TEXT("OK"))
+	{
+		return EResult::Failed;
+	}
+
+	const int32 Width = FCString::Atoi(*Tokens[2]);
+	const int32 Height = FCString::Atoi(*Tokens[3]);
+	const int64 NumBytes = (int64)Width * Height * 4;
+	if (Width <= 0 || Height <= 0 || NumBytes > GetSharedMemorySize(MaxSize))
+	{
+		return EResult::Failed;
+	}
+
+	OutPixels.SetNumUninitialized(NumBytes);
+	FMemory::Memcpy(OutPixels.GetData(), Worker.SharedMemory->GetAddress(), NumBytes);
+	OutWidth = Width;
+	OutHeight = Height;
+	return EResult::Decoded;
+}
@@ -3,14 +3,20 @@
 #include "SAssetTableRow.h"
 #include "FAssetDragDropOp.h"
 #include "FastAssetsThumbnail.h"
+#include "FastAssetsSettings.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
+#include "Widgets/SOverlay.h"
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Images/SImage.h"
 #include "Styling/AppStyle.h"
+#include "CoreGlobals.h"
+#include "FastAssetsStats.h"
 
 #define LOCTEXT_NAMESPACE "FastAssets"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Row Widgets Created"), STAT_FastAssetsRowWidgetsCreated, STATGROUP_FastAssets);
+
 namespace FastAssetsColors
 {
 	FLinearColor GetColorForAssetType(const FString& AssetType)
@@ -52,8 +58,11 @@ namespace FastAssetsColors
 
 void SAssetListRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
 {
-	AssetItem = InArgs._AssetItem;
+	INC_DWORD_STAT(STAT_FastAssetsRowWidgetsCreated);
+
+	SetAssetItem(InArgs._AssetItem);
 	OnDragDetectedDelegate = InArgs._OnDragDetected;
+	OnPaintedDelegate = InArgs._OnPainted;
 
 	SMultiColumnTableRow<TSharedPtr<FExternalAssetItem>>::Construct(
 		FSuperRowType::FArguments()
@@ -62,82 +71,72 @@ void SAssetListRow::Construct(const FArguments& InArgs, const TSharedRef<STableV
 	);
 }
 
-TSharedRef<SWidget> SAssetListRow::GenerateWidgetForColumn(const FName& ColumnName)
+void SAssetListRow::SetAssetItem(const TSharedPtr<FExternalAssetItem>& InAssetItem)
 {
-	if (!AssetItem.IsValid())
-	{
-		return SNullWidget::NullWidget;
-	}
+	AssetItem = InAssetItem;
+	TypeColor = AssetItem.IsValid() ? FastAssetsColors::GetColorForAssetType(AssetItem->AssetType) : FastAssetsColors::GetColorForAssetType(FString());
+}
 
+TSharedRef<SWidget> SAssetListRow::GenerateWidgetForColumn(const FName& ColumnName)
+{
 	if (ColumnName == TEXT("Icon"))
 	{
-		FLinearColor IconColor = FastAssetsColors::GetColorForAssetType(AssetItem->AssetType);
-
-		// Lazy load thumbnail if not already loaded
-		if (AssetItem->ThumbnailBrush == nullptr)
-		{
-			UE_LOG(LogTemp, Log, TEXT("FastAssets: Lazy loading thumbnail for list row: %s"), *AssetItem->FilePath);
-			AssetItem->ThumbnailBrush = FFastAssetsThumbnail::Get().GetThumbnailBrush(
-				AssetItem->FilePath,
-				AssetItem->AssetType
-			);
-			UE_LOG(LogTemp, Log, TEXT("FastAssets: Thumbnail loaded, brush is %s"), AssetItem->ThumbnailBrush ? TEXT("valid") : TEXT("null"));
-		}
-
-		// Check if we have a real thumbnail (for texture files)
-		if (AssetItem->ThumbnailBrush != nullptr && AssetItem->AssetType == TEXT("Texture"))
-		{
-			return SNew(SBox)
-				.WidthOverride(24)
-				.HeightOverride(24)
-				.HAlign(HAlign_Center)
-				.VAlign(VAlign_Center)
-				[
-					SNew(SImage)
-					.Image(AssetItem->ThumbnailBrush)
-				];
-		}
-
-		// Use colored background with type letter
 		return SNew(SBox)
-			.WidthOverride(24)
-			.HeightOverride(24)
+			.WidthOverride(IconSize)
+			.HeightOverride(IconSize)
 			.HAlign(HAlign_Center)
 			.VAlign(VAlign_Center)
 			[
-				SNew(SBorder)
-				.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
-				.BorderBackgroundColor(IconColor)
+				SNew(SOverlay)
+
+				// Real thumbnail once loaded
+				+ SOverlay::Slot()
 				.HAlign(HAlign_Center)
 				.VAlign(VAlign_Center)
-				.Padding(2.0f)
 				[
-					SNew(STextBlock)
-					.Text(FText::FromString(AssetItem->AssetType.Left(1).ToUpper()))
-					.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
-					.ColorAndOpacity(FSlateColor(FLinearColor::White))
+					SNew(SImage)
+					.Image(this, &SAssetListRow::GetThumbnailImage)
+					.Visibility(EVisibility::HitTestInvisible)
+				]
+
+				// Colored background with type letter until then
+				+ SOverlay::Slot()
+				[
+					SNew(SBorder)
+					.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
+					.BorderBackgroundColor(this, &SAssetListRow::GetTypeColor)
+					.HAlign(HAlign_Center)
+					.VAlign(VAlign_Center)
+					.Padding(2.0f)
+					.Visibility(this, &SAssetListRow::GetPlaceholderVisibility)
+					[
+						SNew(STextBlock)
+						.Text(this, &SAssetListRow::GetTypeLetterText)
+						.Font(FCoreStyle::GetDefaultFontStyle("Bold", 10))
+						.ColorAndOpacity(FSlateColor(FLinearColor::White))
+					]
 				]
 			];
 	}
 	else if (ColumnName == TEXT("Name"))
 	{
 		return SNew(STextBlock)
-			.Text(FText::FromString(AssetItem->FileName));
+			.Text(this, &SAssetListRow::GetNameText);
 	}
 	else if (ColumnName == TEXT("Type"))
 	{
 		return SNew(STextBlock)
-			.Text(FText::FromString(AssetItem->AssetType));
+			.Text(this, &SAssetListRow::GetTypeText);
 	}
 	else if (ColumnName == TEXT("Size"))
 	{
 		return SNew(STextBlock)
-			.Text(FText::FromString(FormatFileSize(AssetItem->FileSize)));
+			.Text(this, &SAssetListRow::GetSizeText);
 	}
 	else if (ColumnName == TEXT("Extension"))
 	{
 		return SNew(STextBlock)
-			.Text(FText::FromString(FString::Printf(TEXT(".%s"), *AssetItem->Extension)));
+			.Text(this, &SAssetListRow::GetExtensionText);
 	}
 
 	return SNullWidget::NullWidget;
@@ -163,24 +162,59 @@ FReply SAssetListRow::OnDragDetected(const FGeometry& MyGeometry, const FPointer
 	return FReply::Unhandled();
 }
 
-FString SAssetListRow::FormatFileSize(int64 SizeInBytes) const
+int32 SAssetListRow::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	if (SizeInBytes < 1024)
-	{
-		return FString::Printf(TEXT("%lld B"), SizeInBytes);
-	}
-	else if (SizeInBytes < 1024 * 1024)
-	{
-		return FString::Printf(TEXT("%.1f KB"), SizeInBytes / 1024.0);
-	}
-	else if (SizeInBytes < 1024 * 1024 * 1024)
-	{
-		return FString::Printf(TEXT("%.1f MB"), SizeInBytes / (1024.0 * 1024.0));
-	}
-	else
+	// Only rows that survive culling get here, so this is what is actually on screen
+	if (AssetItem.IsValid())
 	{
-		return FString::Printf(TEXT("%.1f GB"), SizeInBytes / (1024.0 * 1024.0 * 1024.0));
+		const int32 Tier = GetThumbnailTier();
+		AssetItem->ThumbnailLastDrawnFrames[Tier] = GFrameCounter;
+
+		// Renewed every frame while visible; the scheduler cancels it once the row scrolls away
+		if (AssetItem->ThumbnailBrushes[Tier] == nullptr)
+		{
+			FFastAssetsThumbnail::Get().RequestThumbnail(AssetItem, Tier);
+		}
+
+		OnPaintedDelegate.ExecuteIfBound(IndexInList);
 	}
+
+	return SMultiColumnTableRow<TSharedPtr<FExternalAssetItem>>::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+const FSlateBrush* SAssetListRow::GetThumbnailImage() const
+{
+	return AssetItem.IsValid() ? AssetItem->ThumbnailBrushes[GetThumbnailTier()] : nullptr;
+}
+
+EVisibility SAssetListRow::GetPlaceholderVisibility() const
+{
+	return GetThumbnailImage() != nullptr ? EVisibility::Collapsed : EVisibility::HitTestInvisible;
+}
+
+FText SAssetListRow::GetTypeLetterText() const
+{
+	return AssetItem.IsValid() ? AssetItem->TypeLetterText : FText::GetEmpty();
+}
+
+FText SAssetListRow::GetNameText() const
+{
+	return AssetItem.IsValid() ? AssetItem->NameText : FText::GetEmpty();
+}
+
+FText SAssetListRow::GetTypeText() const
+{
+	return AssetItem.IsValid() ? AssetItem->TypeText : FText::GetEmpty();
+}
+
+FText SAssetListRow::GetSizeText() const
+{
+	return AssetItem.IsValid() ? AssetItem->SizeText : FText::GetEmpty();
+}
+
+FText SAssetListRow::GetExtensionText() const
+{
+	return AssetItem.IsValid() ? AssetItem->ExtensionText : FText::GetEmpty();
 }
 
 // ============================================================================
@@ -189,8 +223,11 @@ FString SAssetListRow::FormatFileSize(int64 SizeInBytes) const
 
 void SAssetTile::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable)
 {
-	AssetItem = InArgs._AssetItem;
+	INC_DWORD_STAT(STAT_FastAssetsRowWidgetsCreated);
+
+	SetAssetItem(InArgs._AssetItem);
 	OnDragDetectedDelegate = InArgs._OnDragDetected;
+	OnPaintedDelegate = InArgs._OnPainted;
 
 	STableRow<TSharedPtr<FExternalAssetItem>>::Construct(
 		STableRow<TSharedPtr<FExternalAssetItem>>::FArguments()
@@ -198,36 +235,12 @@ void SAssetTile::Construct(const FArguments& InArgs, const TSharedRef<STableView
 		InOwnerTable
 	);
 
-	// Get color for this asset type
-	FLinearColor TileColor = FLinearColor(0.4f, 0.4f, 0.4f, 1.0f);
-	FString TypeLetter = TEXT("?");
-	bool bHasThumbnail = false;
-
-	if (AssetItem.IsValid())
-	{
-		TileColor = FastAssetsColors::GetColorForAssetType(AssetItem->AssetType);
-		TypeLetter = AssetItem->AssetType.Left(1).ToUpper();
-
-		// Lazy load thumbnail if not already loaded
-		if (AssetItem->ThumbnailBrush == nullptr)
-		{
-			UE_LOG(LogTemp, Log, TEXT("FastAssets: Lazy loading thumbnail for tile: %s"), *AssetItem->FilePath);
-			AssetItem->ThumbnailBrush = FFastAssetsThumbnail::Get().GetThumbnailBrush(
-				AssetItem->FilePath,
-				AssetItem->AssetType
-			);
-			UE_LOG(LogTemp, Log, TEXT("FastAssets: Tile thumbnail loaded, brush is %s"), AssetItem->ThumbnailBrush ? TEXT("valid") : TEXT("null"));
-		}
-
-		bHasThumbnail = (AssetItem->ThumbnailBrush != nullptr && AssetItem->AssetType == TEXT("Texture"));
-		UE_LOG(LogTemp, Log, TEXT("FastAssets: bHasThumbnail = %s for %s"), bHasThumbnail ? TEXT("true") : TEXT("false"), *AssetItem->FileName);
-	}
-
+	// Sizes are bound to the setting as well, so a recycled tile picks up a size change
 	ChildSlot
 	[
 		SNew(SBox)
-		.WidthOverride(110)
-		.HeightOverride(130)
+		.WidthOverride(this, &SAssetTile::GetTileWidth)
+		.HeightOverride(this, &SAssetTile::GetTileHeight)
 		[
 			SNew(SVerticalBox)
 
@@ -236,30 +249,39 @@ void SAssetTile::Construct(const FArguments& InArgs, const TSharedRef<STableView
 			.AutoHeight()
 			[
 				SNew(SBox)
-				.WidthOverride(100)
-				.HeightOverride(100)
+				.WidthOverride(this, &SAssetTile::GetThumbnailBoxSizeOverride)
+				.HeightOverride(this, &SAssetTile::GetThumbnailBoxSizeOverride)
 				[
 					SNew(SBorder)
 					.BorderImage(FAppStyle::GetBrush("WhiteBrush"))
-					.BorderBackgroundColor(TileColor)
+					.BorderBackgroundColor(this, &SAssetTile::GetTypeColor)
 					.Padding(4.0f)
 					.HAlign(HAlign_Center)
 					.VAlign(VAlign_Center)
 					[
-						bHasThumbnail ?
-						// Real thumbnail for textures
-						StaticCastSharedRef<SWidget>(
+						SNew(SOverlay)
+
+						// Real thumbnail once loaded
+						+ SOverlay::Slot()
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						[
 							SNew(SImage)
-							.Image(AssetItem->ThumbnailBrush)
-						)
-						:
-						// Type letter for other assets
-						StaticCastSharedRef<SWidget>(
+							.Image(this, &SAssetTile::GetThumbnailImage)
+							.Visibility(EVisibility::HitTestInvisible)
+						]
+
+						// Type letter as placeholder
+						+ SOverlay::Slot()
+						.HAlign(HAlign_Center)
+						.VAlign(VAlign_Center)
+						[
 							SNew(STextBlock)
-							.Text(FText::FromString(TypeLetter))
+							.Text(this, &SAssetTile::GetTypeLetterText)
 							.Font(FCoreStyle::GetDefaultFontStyle("Bold", 32))
 							.ColorAndOpacity(FSlateColor(FLinearColor::White))
-						)
+							.Visibility(this, &SAssetTile::GetPlaceholderVisibility)
+						]
 					]
 				]
 			]
@@ -271,7 +293,7 @@ void SAssetTile::Construct(const FArguments& InArgs, const TSharedRef<STableView
 			.HAlign(HAlign_Center)
 			[
 				SNew(STextBlock)
-				.Text(AssetItem.IsValid() ? FText::FromString(AssetItem->FileName) : FText::GetEmpty())
+				.Text(this, &SAssetTile::GetNameText)
 				.Justification(ETextJustify::Center)
 				.AutoWrapText(true)
 			]
@@ -279,6 +301,64 @@ void SAssetTile::Construct(const FArguments& InArgs, const TSharedRef<STableView
 	];
 }
 
+void SAssetTile::SetAssetItem(const TSharedPtr<FExternalAssetItem>& InAssetItem)
+{
+	AssetItem = InAssetItem;
+	TypeColor = AssetItem.IsValid() ? FastAssetsColors::GetColorForAssetType(AssetItem->AssetType) : FastAssetsColors::GetColorForAssetType(FString());
+}
+
+int32 SAssetTile::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// Only rows that survive culling get here, so this is what is actually on screen
+	if (AssetItem.IsValid())
+	{
+		const int32 Tier = GetThumbnailTier();
+		AssetItem->ThumbnailLastDrawnFrames[Tier] = GFrameCounter;
+
+		// Renewed every frame while visible; the scheduler cancels it once the row scrolls away
+		if (AssetItem->ThumbnailBrushes[Tier] == nullptr)
+		{
+			FFastAssetsThumbnail::Get().RequestThumbnail(AssetItem, Tier);
+		}
+
+		OnPaintedDelegate.ExecuteIfBound(IndexInList);
+	}
+
+	return STableRow<TSharedPtr<FExternalAssetItem>>::OnPaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+}
+
+int32 SAssetTile::GetThumbnailBoxSize()
+{
+	return UFastAssetsSettings::Get()->GetThumbnailSizePixels();
+}
+
+FVector2D SAssetTile::GetItemSize()
+{
+	// Tile box plus room for the row padding and selection border
+	const int32 ThumbnailBoxSize = GetThumbnailBoxSize();
+	return FVector2D(ThumbnailBoxSize + TileMargin + 10, ThumbnailBoxSize + TileMargin + NameHeight + 10);
+}
+
+const FSlateBrush* SAssetTile::GetThumbnailImage() const
+{
+	return AssetItem.IsValid() ? AssetItem->ThumbnailBrushes[GetThumbnailTier()] : nullptr;
+}
+
+EVisibility SAssetTile::GetPlaceholderVisibility() const
+{
+	return GetThumbnailImage() != nullptr ? EVisibility::Collapsed : EVisibility::HitTestInvisible;
+}
+
+FText SAssetTile::GetTypeLetterText() const
+{
+	return AssetItem.IsValid() ? AssetItem->TypeLetterText : FText::GetEmpty();
+}
+
+FText SAssetTile::GetNameText() const
+{
+	return AssetItem.IsValid() ? AssetItem->NameText : FText::GetEmpty();
+}
+
 FReply SAssetTile::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
 {
 	if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
@@ -0,0 +1,511 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "SFastAssetsDenseGrid.h"
+#include "FastAssetsThumbnail.h"
+#include "FastAssetsSettings.h"
+#include "Widgets/Layout/SScrollBar.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Application/MenuStack.h"
+#include "Rendering/DrawElements.h"
+#include "Rendering/SlateRenderer.h"
+#include "Fonts/FontCache.h"
+#include "Fonts/FontMeasure.h"
+#include "Styling/AppStyle.h"
+#include "Styling/CoreStyle.h"
+#include "CoreGlobals.h"
+#include "Algo/BinarySearch.h"
+
+void SFastAssetsDenseGrid::Construct(const FArguments& InArgs)
+{
+	ItemsSource = InArgs._ItemsSource;
+	ScrollBar = InArgs._ExternalScrollbar;
+	OnSelectionChanged = InArgs._OnSelectionChanged;
+	OnContextMenuOpening = InArgs._OnContextMenuOpening;
+	OnDragDetectedDelegate = InArgs._OnDragDetected;
+	OnPaintedDelegate = InArgs._OnPainted;
+
+	if (ScrollBar.IsValid())
+	{
+		ScrollBar->SetOnUserScrolled(FOnUserScrolled::CreateSP(this, &SFastAssetsDenseGrid::OnScrollbarScrolled));
+	}
+
+	SetClipping(EWidgetClipping::ClipToBounds);
+}
+
+void SFastAssetsDenseGrid::RequestRefresh()
+{
+	// Keep only the selected items that are still shown; costs a lookup per selected item, not per item
+	int32 NumRemoved = 0;
+	for (auto It = SelectedItems.CreateIterator(); It; ++It)
+	{
+		if (!IsInItemsSource(*It))
+		{
+			It.RemoveCurrent();
+			NumRemoved++;
+		}
+	}
+
+	SelectionAnchor = INDEX_NONE;
+	PendingSelectIndex = INDEX_NONE;
+	PressedIndex = INDEX_NONE;
+	HoveredIndex = INDEX_NONE;
+
+	SetScrollOffset(ScrollOffset);
+
+	if (NumRemoved > 0)
+	{
+		NotifySelectionChanged(nullptr);
+	}
+}
+
+void SFastAssetsDenseGrid::SetPagedItems(const TSharedPtr<IFastAssetsItemSource>& Source)
+{
+	PagedItems = Source;
+	RequestRefresh();
+}
+
+void SFastAssetsDenseGrid::ShiftScrollAnchor(int32 OldIndex, int32 NewIndex)
+{
+	const int32 NumColumns = GetNumColumns(ViewWidth);
+	SetScrollOffset(ScrollOffset + (NewIndex / NumColumns - OldIndex / NumColumns) * GetTileSize().Y);
+}
+
+bool SFastAssetsDenseGrid::IsInItemsSource(const TSharedPtr<FExternalAssetItem>& Item) const
+{
+	if (!Item.IsValid())
+	{
+		return false;
+	}
+
+	if (PagedItems.IsValid())
+	{
+		return PagedItems->FindItem(*Item) != INDEX_NONE;
+	}
+
+	if (!ItemsSource)
+	{
+		return false;
+	}
+
+	const int32 Index = Algo::LowerBoundBy(*ItemsSource, Item->SortIndex, [](const TSharedPtr<FExternalAssetItem>& Other) { return Other->SortIndex; });
+	return ItemsSource->IsValidIndex(Index) && (*ItemsSource)[Index] == Item;
+}
+
+TArray<TSharedPtr<FExternalAssetItem>> SFastAssetsDenseGrid::GetSelectedItems() const
+{
+	return SelectedItems.Array();
+}
+
+int32 SFastAssetsDenseGrid::GetThumbnailSize()
+{
+	return FMath::Max(UFastAssetsSettings::Get()->GetThumbnailSizePixels() / 2, FastAssetsThumbnailTier::GetSize(0));
+}
+
+int32 SFastAssetsDenseGrid::GetThumbnailTier()
+{
+	return FastAssetsThumbnailTier::ForSize(GetThumbnailSize());
+}
+
+FVector2D SFastAssetsDenseGrid::GetTileSize()
+{
+	const float ThumbnailSize = GetThumbnailSize();
+	return FVector2D(ThumbnailSize + TilePadding * 2.0f, ThumbnailSize + LabelHeight + TilePadding * 2.0f);
+}
+
+int32 SFastAssetsDenseGrid::GetNumColumns(float InViewWidth) const
+{
+	return FMath::Max(FMath::FloorToInt(InViewWidth / GetTileSize().X), 1);
+}
+
+int32 SFastAssetsDenseGrid::GetIndexAt(const FVector2D& LocalPosition) const
+{
+	const FVector2D TileSize = GetTileSize();
+	const int32 NumColumns = GetNumColumns(ViewWidth);
+
+	const int32 Column = FMath::FloorToInt(LocalPosition.X / TileSize.X);
+	const int32 Row = FMath::FloorToInt((LocalPosition.Y + ScrollOffset) / TileSize.Y);
+	if (LocalPosition.X < 0.0f || Column >= NumColumns || Row < 0)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Index = Row * NumColumns + Column;
+	return Index < GetNumItems() ? Index : INDEX_NONE;
+}
+
+float SFastAssetsDenseGrid::GetMaxScrollOffset() const
+{
+	const int32 NumRows = FMath::DivideAndRoundUp(GetNumItems(), GetNumColumns(ViewWidth));
+	return FMath::Max(NumRows * GetTileSize().Y - ViewHeight, 0.0f);
+}
+
+void SFastAssetsDenseGrid::SetScrollOffset(float NewOffset)
+{
+	ScrollOffset = FMath::Clamp(NewOffset, 0.0f, GetMaxScrollOffset());
+}
+
+void SFastAssetsDenseGrid::OnScrollbarScrolled(float OffsetFraction)
+{
+	const float ContentHeight = GetMaxScrollOffset() + ViewHeight;
+	SetScrollOffset(OffsetFraction * ContentHeight);
+}
+
+FVector2D SFastAssetsDenseGrid::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Fills whatever it is given and scrolls the rest
+	return GetTileSize();
+}
+
+void SFastAssetsDenseGrid::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	ViewWidth = LocalSize.X;
+	ViewHeight = LocalSize.Y;
+
+	// The item count or width may have changed since the offset was set
+	SetScrollOffset(ScrollOffset);
+
+	if (ScrollBar.IsValid())
+	{
+		const float ContentHeight = GetMaxScrollOffset() + ViewHeight;
+		if (ContentHeight > 0.0f)
+		{
+			ScrollBar->SetState(ScrollOffset / ContentHeight, ViewHeight / ContentHeight);
+		}
+	}
+}
+
+int32 SFastAssetsDenseGrid::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const int32 NumItems = GetNumItems();
+	if (NumItems == 0)
+	{
+		return LayerId;
+	}
+
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	const FVector2D TileSize = GetTileSize();
+	const float ThumbnailSize = GetThumbnailSize();
+	const int32 NumColumns = GetNumColumns(LocalSize.X);
+
+	const int32 FirstRow = FMath::FloorToInt(ScrollOffset / TileSize.Y);
+	const int32 LastRow = FMath::CeilToInt((ScrollOffset + LocalSize.Y) / TileSize.Y);
+	const int32 FirstIndex = FMath::Clamp(FirstRow * NumColumns, 0, NumItems);
+	const int32 EndIndex = FMath::Clamp(LastRow * NumColumns, 0, NumItems);
+	if (FirstIndex >= EndIndex)
+	{
+		return LayerId;
+	}
+
+	// Labels are shaped at the final pixel scale so they stay sharp at any DPI
+	const float FontScale = AllottedGeometry.Scale;
+	if (FontScale != LabelCacheScale || LabelCache.Num() > MaxCachedLabels)
+	{
+		LabelCache.Empty();
+		TypeLetterCache.Empty();
+		LabelCacheScale = FontScale;
+	}
+
+	// One layer per kind of element, so each kind batches into as few draw calls as possible
+	const int32 BackgroundLayer = LayerId;
+	const int32 ThumbnailLayer = LayerId + 1;
+	const int32 TextLayer = LayerId + 2;
+
+	const FSlateBrush* WhiteBrush = FAppStyle::GetBrush("WhiteBrush");
+	const FLinearColor SelectionColor = FAppStyle::Get().GetSlateColor("SelectionColor").GetSpecifiedColor();
+	const FLinearColor HoverColor(1.0f, 1.0f, 1.0f, 0.08f);
+	const FLinearColor TextColor = InWidgetStyle.GetColorAndOpacityTint() * FLinearColor(0.9f, 0.9f, 0.9f, 1.0f);
+	const ESlateDrawEffect DrawEffects = ShouldBeEnabled(bParentEnabled) ? ESlateDrawEffect::None : ESlateDrawEffect::DisabledEffect;
+	const float InvFontScale = 1.0f / FontScale;
+
+	const int32 Tier = GetThumbnailTier();
+	FFastAssetsThumbnail& Thumbnails = FFastAssetsThumbnail::Get();
+
+	for (int32 Index = FirstIndex; Index < EndIndex; Index++)
+	{
+		const TSharedPtr<FExternalAssetItem> Item = GetItem(Index);
+		if (!Item.IsValid())
+		{
+			continue;
+		}
+
+		const FVector2D TileOrigin((Index % NumColumns) * TileSize.X, (Index / NumColumns) * TileSize.Y - ScrollOffset);
+		const FVector2D ThumbnailOrigin = TileOrigin + FVector2D(TilePadding, TilePadding);
+
+		if (IsSelected(Item) || Index == HoveredIndex)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+				AllottedGeometry.ToPaintGeometry(TileSize, FSlateLayoutTransform(TileOrigin)),
+				WhiteBrush, DrawEffects, IsSelected(Item) ? SelectionColor : HoverColor);
+		}
+
+		const FLinearColor TypeColor = FastAssetsColors::GetColorForAssetType(Item->AssetType);
+
+		// Same visibility bookkeeping and request as a tile widget
+		Item->ThumbnailLastDrawnFrames[Tier] = GFrameCounter;
+		const FSlateBrush* ThumbnailBrush = Item->ThumbnailBrushes[Tier];
+		if (ThumbnailBrush == nullptr)
+		{
+			Thumbnails.RequestThumbnail(Item, Tier);
+
+			// Type colored placeholder with its letter until the thumbnail arrives
+			FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2D(ThumbnailSize, ThumbnailSize), FSlateLayoutTransform(ThumbnailOrigin)),
+				WhiteBrush, DrawEffects, TypeColor);
+
+			FShapedGlyphSequenceRef Letter = GetShapedTypeLetter(*Item, FontScale);
+			const FVector2D LetterSize(Letter->GetMeasuredWidth() * InvFontScale, Letter->GetMaxTextHeight() * InvFontScale);
+			FSlateDrawElement::MakeShapedText(OutDrawElements, TextLayer,
+				AllottedGeometry.ToPaintGeometry(LetterSize, FSlateLayoutTransform(ThumbnailOrigin + (FVector2D(ThumbnailSize, ThumbnailSize) - LetterSize) * 0.5f)),
+				Letter, DrawEffects, FLinearColor::White, FLinearColor::Transparent);
+		}
+		else
+		{
+			// Fit the thumbnail into its square, keeping the aspect ratio
+			const FVector2D ImageSize(ThumbnailBrush->GetImageSize());
+			const float Scale = ThumbnailSize / FMath::Max<float>(FMath::Max(ImageSize.X, ImageSize.Y), 1.0f);
+			const FVector2D DrawSize = ImageSize * Scale;
+
+			FSlateDrawElement::MakeBox(OutDrawElements, ThumbnailLayer,
+				AllottedGeometry.ToPaintGeometry(DrawSize, FSlateLayoutTransform(ThumbnailOrigin + (FVector2D(ThumbnailSize, ThumbnailSize) - DrawSize) * 0.5f)),
+				ThumbnailBrush, DrawEffects, InWidgetStyle.GetColorAndOpacityTint());
+
+			// Thin type colored badge under the thumbnail
+			FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+				AllottedGeometry.ToPaintGeometry(FVector2D(ThumbnailSize, BadgeHeight), FSlateLayoutTransform(ThumbnailOrigin + FVector2D(0.0f, ThumbnailSize - BadgeHeight))),
+				WhiteBrush, DrawEffects, TypeColor);
+		}
+
+		FShapedGlyphSequenceRef Label = GetShapedLabel(Item, FontScale, ThumbnailSize * FontScale);
+		const FVector2D LabelSize(Label->GetMeasuredWidth() * InvFontScale, Label->GetMaxTextHeight() * InvFontScale);
+		const FVector2D LabelOrigin(ThumbnailOrigin.X + (ThumbnailSize - LabelSize.X) * 0.5f, ThumbnailOrigin.Y + ThumbnailSize + (LabelHeight - LabelSize.Y) * 0.5f);
+		FSlateDrawElement::MakeShapedText(OutDrawElements, TextLayer,
+			AllottedGeometry.ToPaintGeometry(LabelSize, FSlateLayoutTransform(LabelOrigin)),
+			Label, DrawEffects, TextColor, FLinearColor::Transparent);
+	}
+
+	// The window only needs the painted range to prefetch around it
+	OnPaintedDelegate.ExecuteIfBound(FirstIndex);
+	OnPaintedDelegate.ExecuteIfBound(EndIndex - 1);
+
+	return TextLayer;
+}
+
+FShapedGlyphSequenceRef SFastAssetsDenseGrid::GetShapedLabel(const TSharedPtr<FExternalAssetItem>& Item, float FontScale, float MaxWidth) const
+{
+	const FCachedLabel* Cached = LabelCache.Find(Item.Get());
+	if (Cached && Cached->Item.HasSameObject(Item.Get()))
+	{
+		return Cached->Label;
+	}
+
+	const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Regular", 7);
+	FSlateRenderer* Renderer = FSlateApplication::Get().GetRenderer();
+	TSharedRef<FSlateFontCache> FontCache = Renderer->GetFontCache();
+
+	// Cut long names to the tile width with an ellipsis; done once, not every frame
+	FString Text = Item->FileName;
+	FShapedGlyphSequenceRef Shaped = FontCache->ShapeBidirectionalText(Text, Font, FontScale, TextBiDi::ETextDirection::LeftToRight, ETextShapingMethod::Auto);
+	if (Shaped->GetMeasuredWidth() > MaxWidth)
+	{
+		static const FString Ellipsis = TEXT("...");
+		TSharedRef<FSlateFontMeasure> FontMeasure = Renderer->GetFontMeasureService();
+		const float EllipsisWidth = FontMeasure->Measure(Ellipsis, Font, FontScale).X;
+		const int32 LastIndex = FontMeasure->FindLastWholeCharacterIndexBeforeOffset(Text, Font, FMath::Max(FMath::FloorToInt(MaxWidth - EllipsisWidth), 0), FontScale);
+
+		Text = Text.Left(FMath::Max(LastIndex, 0)) + Ellipsis;
+		Shaped = FontCache->ShapeBidirectionalText(Text, Font, FontScale, TextBiDi::ETextDirection::LeftToRight, ETextShapingMethod::Auto);
+	}
+
+	LabelCache.Add(Item.Get(), FCachedLabel{ Item, Shaped });
+	return Shaped;
+}
+
+FShapedGlyphSequenceRef SFastAssetsDenseGrid::GetShapedTypeLetter(const FExternalAssetItem& Item, float FontScale) const
+{
+	if (const FShapedGlyphSequenceRef* Cached = TypeLetterCache.Find(Item.AssetType))
+	{
+		return *Cached;
+	}
+
+	const FSlateFontInfo Font = FCoreStyle::GetDefaultFontStyle("Bold", 12);
+	TSharedRef<FSlateFontCache> FontCache = FSlateApplication::Get().GetRenderer()->GetFontCache();
+	FShapedGlyphSequenceRef Shaped = FontCache->ShapeBidirectionalText(Item.AssetType.Left(1).ToUpper(), Font, FontScale, TextBiDi::ETextDirection::LeftToRight, ETextShapingMethod::Auto);
+
+	TypeLetterCache.Add(Item.AssetType, Shaped);
+	return Shaped;
+}
+
+FReply SFastAssetsDenseGrid::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() != EKeys::LeftMouseButton)
+	{
+		return FReply::Handled();
+	}
+
+	const int32 Index = GetIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+	PressedIndex = Index;
+	PendingSelectIndex = INDEX_NONE;
+
+	FReply Reply = FReply::Handled().SetUserFocus(SharedThis(this), EFocusCause::Mouse);
+
+	if (Index == INDEX_NONE)
+	{
+		if (!MouseEvent.IsControlDown() && !MouseEvent.IsShiftDown())
+		{
+			ClearSelection();
+		}
+		return Reply;
+	}
+
+	if (MouseEvent.IsShiftDown())
+	{
+		SelectRange(SelectionAnchor == INDEX_NONE ? Index : SelectionAnchor, Index);
+	}
+	else if (MouseEvent.IsControlDown())
+	{
+		ToggleSelected(Index);
+	}
+	else if (IsSelected(GetItem(Index)))
+	{
+		// Keep a multi-selection intact in case this press starts a drag
+		PendingSelectIndex = Index;
+	}
+	else
+	{
+		SelectSingle(Index);
+	}
+
+	return Reply.DetectDrag(SharedThis(this), EKeys::LeftMouseButton);
+}
+
+FReply SFastAssetsDenseGrid::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+	{
+		if (PendingSelectIndex != INDEX_NONE)
+		{
+			SelectSingle(PendingSelectIndex);
+			PendingSelectIndex = INDEX_NONE;
+		}
+		return FReply::Handled();
+	}
+
+	if (MouseEvent.GetEffectingButton() == EKeys::RightMouseButton)
+	{
+		// Right clicking an unselected item selects it alone, like the list views
+		const int32 Index = GetIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+		if (Index != INDEX_NONE && !IsSelected(GetItem(Index)))
+		{
+			SelectSingle(Index);
+		}
+
+		TSharedPtr<SWidget> MenuContent = OnContextMenuOpening.IsBound() ? OnContextMenuOpening.Execute() : nullptr;
+		if (MenuContent.IsValid())
+		{
+			const FWidgetPath WidgetPath = MouseEvent.GetEventPath() != nullptr ? *MouseEvent.GetEventPath() : FWidgetPath();
+			FSlateApplication::Get().PushMenu(SharedThis(this), WidgetPath, MenuContent.ToSharedRef(), MouseEvent.GetScreenSpacePosition(), FPopupTransitionEffect(FPopupTransitionEffect::ContextMenu));
+		}
+		return FReply::Handled();
+	}
+
+	return FReply::Unhandled();
+}
+
+FReply SFastAssetsDenseGrid::OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	HoveredIndex = GetIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+	return FReply::Unhandled();
+}
+
+void SFastAssetsDenseGrid::OnMouseLeave(const FPointerEvent& MouseEvent)
+{
+	SLeafWidget::OnMouseLeave(MouseEvent);
+	HoveredIndex = INDEX_NONE;
+}
+
+FReply SFastAssetsDenseGrid::OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	SetScrollOffset(ScrollOffset - MouseEvent.GetWheelDelta() * GetTileSize().Y);
+	HoveredIndex = GetIndexAt(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition()));
+	return FReply::Handled();
+}
+
+FReply SFastAssetsDenseGrid::OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	PendingSelectIndex = INDEX_NONE;
+
+	if (PressedIndex != INDEX_NONE && PressedIndex < GetNumItems() && OnDragDetectedDelegate.IsBound())
+	{
+		return OnDragDetectedDelegate.Execute(GetItem(PressedIndex));
+	}
+
+	return FReply::Unhandled();
+}
+
+FReply SFastAssetsDenseGrid::OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent)
+{
+	if (InKeyEvent.GetKey() == EKeys::A && InKeyEvent.IsControlDown() && GetNumItems() > 0)
+	{
+		SelectRange(0, GetNumItems() - 1);
+		return FReply::Handled();
+	}
+
+	if (InKeyEvent.GetKey() == EKeys::PageDown || InKeyEvent.GetKey() == EKeys::PageUp)
+	{
+		SetScrollOffset(ScrollOffset + (InKeyEvent.GetKey() == EKeys::PageDown ? ViewHeight : -ViewHeight));
+		return FReply::Handled();
+	}
+
+	return FReply::Unhandled();
+}
+
+void SFastAssetsDenseGrid::SelectSingle(int32 Index)
+{
+	const TSharedPtr<FExternalAssetItem> Item = GetItem(Index);
+	SelectedItems.Reset();
+	SelectedItems.Add(Item);
+	SelectionAnchor = Index;
+	NotifySelectionChanged(Item);
+}
+
+void SFastAssetsDenseGrid::SelectRange(int32 FromIndex, int32 ToIndex)
+{
+	if (PagedItems.IsValid() && FMath::Abs(ToIndex - FromIndex) >= MaxPagedRangeSelection)
+	{
+		ToIndex = FromIndex + (FromIndex < ToIndex ? MaxPagedRangeSelection - 1 : 1 - MaxPagedRangeSelection);
+	}
+
+	SelectedItems.Reset();
+	for (int32 Index = FMath::Min(FromIndex, ToIndex); Index <= FMath::Max(FromIndex, ToIndex); Index++)
+	{
+		SelectedItems.Add(GetItem(Index));
+	}
+	NotifySelectionChanged(GetItem(ToIndex));
+}
+
+void SFastAssetsDenseGrid::ToggleSelected(int32 Index)
+{
+	const TSharedPtr<FExternalAssetItem> Item = GetItem(Index);
+	if (SelectedItems.Remove(Item) == 0)
+	{
+		SelectedItems.Add(Item);
+	}
+	SelectionAnchor = Index;
+	NotifySelectionChanged(Item);
+}
+
+void SFastAssetsDenseGrid::ClearSelection()
+{
+	if (SelectedItems.Num() > 0)
+	{
+		SelectedItems.Reset();
+		SelectionAnchor = INDEX_NONE;
+		NotifySelectionChanged(nullptr);
+	}
+}
+
+void SFastAssetsDenseGrid::NotifySelectionChanged(const TSharedPtr<FExternalAssetItem>& Item)
+{
+	OnSelectionChanged.ExecuteIfBound(Item, ESelectInfo::OnMouseClick);
+}
@@ -2,12 +2,18 @@
 
 #include "SFastAssetsWindow.h"
 #include "SAssetTableRow.h"
+#include "SFastAssetsDenseGrid.h"
 #include "FAssetDragDropOp.h"
 #include "FastAssetImporter.h"
 #include "SFastAssetsSettingsDialog.h"
 #include "FastAssetsSettings.h"
 #include "FastAssetsDropHandler.h"
+#include "FastAssetsThumbnail.h"
 #include "FastAssets.h"
+#include "FastAssetsStats.h"
+#include "FastAssetsUpdateApplier.h"
+#include "FastAssetsCatalog.h"
+#include "FastAssetsSharedCatalog.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
 #include "HAL/PlatformProcess.h"
 #include "HAL/PlatformApplicationMisc.h"
@@ -15,8 +21,8 @@
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Layout/SBorder.h"
 #include "Widgets/Layout/SSplitter.h"
-#include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Layout/SWidgetSwitcher.h"
+#include "Widgets/Layout/SScrollBar.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Input/SSearchBox.h"
@@ -31,9 +37,49 @@
 #include "HAL/PlatformFileManager.h"
 #include "Misc/Paths.h"
 #include "Async/Async.h"
+#include "Algo/BinarySearch.h"
+#include "String/Find.h"
 
 #define LOCTEXT_NAMESPACE "FastAssets"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Row Widgets Recycled"), STAT_FastAssetsRowWidgetsRecycled, STATGROUP_FastAssets);
+
+/**
+ * Items of a catalog view on disk, built only for the records the dense grid or the prefetch look at.
+ * Items come from the shared catalog, so windows showing the same records share them and their thumbnails.
+ */
+class FFastAssetsCatalogItemSource : public IFastAssetsItemSource
+{
+public:
+	FFastAssetsCatalogItemSource(const TSharedRef<FFastAssetsSharedCatalog>& InSharedCatalog, const TSharedRef<FFastAssetsCatalogView>& InView)
+		: SharedCatalog(InSharedCatalog)
+		, View(InView)
+	{
+	}
+
+	const TSharedRef<FFastAssetsCatalogView>& GetView() const { return View; }
+
+	/** Show another view of the same catalog; items are shared, so selection and thumbnails carry over */
+	void SetView(const TSharedRef<FFastAssetsCatalogView>& InView) { View = InView; }
+
+	virtual int32 Num() const override { return View->Num(); }
+
+	virtual TSharedPtr<FExternalAssetItem> GetItem(int32 Index) const override
+	{
+		return SharedCatalog->GetDiskItem(View->GetCatalog(), View->GetRecordIndex(Index));
+	}
+
+	virtual int32 FindItem(const FExternalAssetItem& Item) const override
+	{
+		// SortIndex is the record index, but only for items built from the catalog this view filtered
+		return View->GetCatalog() == SharedCatalog->GetDiskCatalog() && SharedCatalog->IsDiskItem(Item) ? View->Find(Item.SortIndex) : INDEX_NONE;
+	}
+
+private:
+	TSharedRef<FFastAssetsSharedCatalog> SharedCatalog;
+	TSharedRef<FFastAssetsCatalogView> View;
+};
+
 void SFastAssetsWindow::Construct(const FArguments& InArgs)
 {
 	// Load settings
@@ -54,6 +100,11 @@ void SFastAssetsWindow::Construct(const FArguments& InArgs)
 		CurrentPath = FPaths::ProjectContentDir();
 	}
 
+	if (!InArgs._InitialPath.IsEmpty())
+	{
+		CurrentPath = InArgs._InitialPath;
+	}
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -98,10 +149,50 @@ void SFastAssetsWindow::Construct(const FArguments& InArgs)
 			ConstructStatusBar()
 		]
 	];
+
+	// Opened for a folder, such as one shown in another tab; shares that tab's scan if it is still open
+	if (!InArgs._InitialPath.IsEmpty())
+	{
+		ScanDirectory(CurrentPath);
+	}
 }
 
 SFastAssetsWindow::~SFastAssetsWindow()
 {
+	if (Catalog.IsValid())
+	{
+		Catalog->OnChanged().Remove(CatalogChangedHandle);
+	}
+
+	if (FilterCancelFlag.IsValid())
+	{
+		*FilterCancelFlag = true;
+	}
+
+	// The pending refresh calls back into this window
+	FFastAssetsUpdateApplier::Get().CancelRefresh(this);
+}
+
+void SFastAssetsWindow::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
+{
+	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
+
+	// Tiles follow the thumbnail size setting, lay them out again when it changes
+	const int32 ThumbnailBoxSize = SAssetTile::GetThumbnailBoxSize();
+	if (ThumbnailBoxSize != TileThumbnailBoxSize)
+	{
+		TileThumbnailBoxSize = ThumbnailBoxSize;
+		RequestViewRefresh();
+	}
+
+	// Follow the dense grid setting and whether a catalog on disk is shown
+	if (ViewSwitcher.IsValid() && ViewSwitcher->GetActiveWidgetIndex() != GetViewWidgetIndex())
+	{
+		ViewSwitcher->SetActiveWidgetIndex(GetViewWidgetIndex());
+		OnAssetSelectionChanged(nullptr, ESelectInfo::Direct);
+	}
+
+	UpdateThumbnailPrefetch();
 }
 
 TSharedRef<SWidget> SFastAssetsWindow::ConstructToolbar()
@@ -130,6 +221,17 @@ TSharedRef<SWidget> SFastAssetsWindow::ConstructToolbar()
 			.OnClicked(this, &SFastAssetsWindow::OnRefreshClicked)
 		]
 
+		// New Tab Button
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(2.0f, 0.0f)
+		[
+			SNew(SButton)
+			.Text(LOCTEXT("NewTabButton", "New Tab"))
+			.ToolTipText(LOCTEXT("NewTabTooltip", "Open another FastAssets tab on the current folder"))
+			.OnClicked(this, &SFastAssetsWindow::OnNewTabClicked)
+		]
+
 		// Settings Button
 		+ SHorizontalBox::Slot()
 		.AutoWidth()
@@ -217,6 +319,21 @@ TSharedRef<SWidget> SFastAssetsWindow::ConstructSearchBar()
 		];
 }
 
+TSharedRef<SWidget> SFastAssetsWindow::ConstructFolderTree()
+{
+	return SNew(SBorder)
+		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+		.Padding(4.0f)
+		[
+			SAssignNew(FolderTreeView, STreeView<TSharedPtr<FFastAssetsFolderNode>>)
+			.TreeItemsSource(&FolderTreeRoots)
+			.OnGenerateRow(this, &SFastAssetsWindow::OnGenerateFolderRow)
+			.OnGetChildren(this, &SFastAssetsWindow::OnGetFolderChildren)
+			.OnSelectionChanged(this, &SFastAssetsWindow::OnFolderSelectionChanged)
+			.SelectionMode(ESelectionMode::Single)
+		];
+}
+
 TSharedRef<SWidget> SFastAssetsWindow::ConstructContentArea()
 {
 	// Create List View with header
@@ -245,6 +362,7 @@ TSharedRef<SWidget> SFastAssetsWindow::ConstructContentArea()
 	SAssignNew(AssetListView, SListView<TSharedPtr<FExternalAssetItem>>)
 		.ListItemsSource(&FilteredAssets)
 		.OnGenerateRow(this, &SFastAssetsWindow::OnGenerateAssetRow)
+		.OnRowReleased(this, &SFastAssetsWindow::OnAssetRowReleased)
 		.OnSelectionChanged(this, &SFastAssetsWindow::OnAssetSelectionChanged)
 		.OnContextMenuOpening(this, &SFastAssetsWindow::OnContextMenuOpening)
 		.SelectionMode(ESelectionMode::Multi)
@@ -254,34 +372,75 @@ TSharedRef<SWidget> SFastAssetsWindow::ConstructContentArea()
 	SAssignNew(AssetTileView, STileView<TSharedPtr<FExternalAssetItem>>)
 		.ListItemsSource(&FilteredAssets)
 		.OnGenerateTile(this, &SFastAssetsWindow::OnGenerateAssetTile)
+		.OnTileReleased(this, &SFastAssetsWindow::OnAssetTileReleased)
 		.OnSelectionChanged(this, &SFastAssetsWindow::OnAssetSelectionChanged)
 		.OnContextMenuOpening(this, &SFastAssetsWindow::OnContextMenuOpening)
 		.SelectionMode(ESelectionMode::Multi)
-		.ItemWidth(120)
-		.ItemHeight(140);
+		.ItemWidth_Lambda([]() { return SAssetTile::GetItemSize().X; })
+		.ItemHeight_Lambda([]() { return SAssetTile::GetItemSize().Y; });
 
-	return SNew(SBorder)
-		.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
-		.Padding(4.0f)
+	TileThumbnailBoxSize = SAssetTile::GetThumbnailBoxSize();
+
+	// Create Dense Grid
+	TSharedRef<SScrollBar> DenseGridScrollBar = SNew(SScrollBar);
+	SAssignNew(DenseGrid, SFastAssetsDenseGrid)
+		.ItemsSource(&FilteredAssets)
+		.ExternalScrollbar(DenseGridScrollBar)
+		.OnSelectionChanged(this, &SFastAssetsWindow::OnAssetSelectionChanged)
+		.OnContextMenuOpening(this, &SFastAssetsWindow::OnContextMenuOpening)
+		.OnDragDetected(FOnAssetDragDetected::CreateSP(this, &SFastAssetsWindow::OnAssetDragDetected))
+		.OnPainted(FOnAssetRowPainted::CreateSP(this, &SFastAssetsWindow::OnAssetRowPainted));
+
+	// Folder tree beside the content
+	return SNew(SSplitter)
+		.Orientation(Orient_Horizontal)
+
+		+ SSplitter::Slot()
+		.Value(0.2f)
 		[
-			SAssignNew(ViewSwitcher, SWidgetSwitcher)
-			.WidgetIndex(CurrentViewMode == EFastAssetsViewMode::Grid ? 0 : 1)
+			ConstructFolderTree()
+		]
 
-			// Grid View (Index 0)
-			+ SWidgetSwitcher::Slot()
-			[
-				SNew(SScrollBox)
-				+ SScrollBox::Slot()
+		+ SSplitter::Slot()
+		.Value(0.8f)
+		[
+			SNew(SBorder)
+				.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+				.Padding(4.0f)
 				[
-					AssetTileView.ToSharedRef()
+					SAssignNew(ViewSwitcher, SWidgetSwitcher)
+					.WidgetIndex(GetViewWidgetIndex())
+
+					// Grid View (Index 0); scrolls itself so it only generates the rows in view
+					+ SWidgetSwitcher::Slot()
+					[
+						AssetTileView.ToSharedRef()
+					]
+
+					// List View (Index 1)
+					+ SWidgetSwitcher::Slot()
+					[
+						AssetListView.ToSharedRef()
+					]
+
+					// Dense Grid View (Index 2), used for the grid when enabled in the settings
+					+ SWidgetSwitcher::Slot()
+					[
+						SNew(SHorizontalBox)
+
+						+ SHorizontalBox::Slot()
+						.FillWidth(1.0f)
+						[
+							DenseGrid.ToSharedRef()
+						]
+
+						+ SHorizontalBox::Slot()
+						.AutoWidth()
+						[
+							DenseGridScrollBar
+						]
+					]
 				]
-			]
-
-			// List View (Index 1)
-			+ SWidgetSwitcher::Slot()
-			[
-				AssetListView.ToSharedRef()
-			]
 		];
 }
 
@@ -340,6 +499,12 @@ FReply SFastAssetsWindow::OnRefreshClicked()
 	return FReply::Handled();
 }
 
+FReply SFastAssetsWindow::OnNewTabClicked()
+{
+	FFastAssetsModule::Get().OpenNewFastAssetsTab(CurrentPath);
+	return FReply::Handled();
+}
+
 FReply SFastAssetsWindow::OnSettingsClicked()
 {
 	SFastAssetsSettingsDialog::ShowDialog();
@@ -351,7 +516,7 @@ FReply SFastAssetsWindow::OnGridViewClicked()
 	CurrentViewMode = EFastAssetsViewMode::Grid;
 	if (ViewSwitcher.IsValid())
 	{
-		ViewSwitcher->SetActiveWidgetIndex(0);
+		ViewSwitcher->SetActiveWidgetIndex(GetViewWidgetIndex());
 	}
 	return FReply::Handled();
 }
@@ -361,7 +526,7 @@ FReply SFastAssetsWindow::OnListViewClicked()
 	CurrentViewMode = EFastAssetsViewMode::List;
 	if (ViewSwitcher.IsValid())
 	{
-		ViewSwitcher->SetActiveWidgetIndex(1);
+		ViewSwitcher->SetActiveWidgetIndex(GetViewWidgetIndex());
 	}
 	return FReply::Handled();
 }
@@ -386,181 +551,433 @@ FText SFastAssetsWindow::GetCurrentPathText() const
 
 void SFastAssetsWindow::OnSearchTextChanged(const FText& NewText)
 {
-	SearchText = NewText.ToString();
-	RefreshFilteredAssets();
+	const FString NewSearchText = NewText.ToString();
+
+	// Typing more can only drop items, so only the ones shown now need testing
+	const bool bNarrowing = NewSearchText.Contains(SearchText, ESearchCase::IgnoreCase);
+
+	SearchText = NewSearchText;
+	RefreshFilteredAssets(bNarrowing);
 }
 
 void SFastAssetsWindow::ScanDirectory(const FString& Path)
 {
-	AllAssets.Empty();
+	TSharedRef<FFastAssetsSharedCatalog> NewCatalog = FFastAssetsSharedCatalog::Get(Path);
+	if (NewCatalog == Catalog)
+	{
+		NewCatalog->Rescan();
+		return;
+	}
+
+	ShowCatalog(NewCatalog);
+	NewCatalog->EnsureScanned();
+}
+
+void SFastAssetsWindow::ShowCatalog(const TSharedRef<FFastAssetsSharedCatalog>& NewCatalog)
+{
+	if (Catalog.IsValid())
+	{
+		Catalog->OnChanged().Remove(CatalogChangedHandle);
+	}
+
+	Catalog = NewCatalog;
+	CatalogChangedHandle = NewCatalog->OnChanged().AddSP(this, &SFastAssetsWindow::OnCatalogChanged);
+
+	// Nothing shown for the previous folder carries over
 	FilteredAssets.Empty();
+	LastFirstVisibleIndex = INDEX_NONE;
+	SetCatalogItems(nullptr);
 
-	if (StatusText.IsValid())
+	OnCatalogChanged(INDEX_NONE);
+}
+
+void SFastAssetsWindow::OnCatalogChanged(int32 FirstAddedIndex)
+{
+	// A new folder or a finished scan to disk replaced the folder tree; the old tree and its selection go
+	const TSharedPtr<FFastAssetsFolderNode> Root = Catalog->GetFolderTree().GetRoot();
+	if (FolderTreeRoots.Num() == 0 || FolderTreeRoots[0] != Root)
+	{
+		FolderFilterPrefix.Empty();
+		FolderTreeRoots = { Root };
+		if (FolderTreeView.IsValid())
+		{
+			FolderTreeView->ClearSelection();
+			FolderTreeView->SetItemExpansion(Root, true);
+		}
+	}
+
+	if (FirstAddedIndex == INDEX_NONE)
+	{
+		RefreshFilteredAssets();
+		return;
+	}
+
+	// Appending keeps every index on screen valid, so widgets, selection and scroll position are untouched
+	const TArray<TSharedPtr<FExternalAssetItem>>& Assets = Catalog->GetAssets();
+	for (int32 Index = FirstAddedIndex; Index < Assets.Num(); Index++)
+	{
+		if (PassesFilter(Assets[Index]))
+		{
+			FilteredAssets.Add(Assets[Index]);
+		}
+	}
+
+	RequestViewRefresh();
+}
+
+TSharedRef<ITableRow> SFastAssetsWindow::OnGenerateAssetRow(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	// Rebind a row that scrolled out instead of building a new widget tree
+	if (ListRowPool.Num() > 0)
+	{
+		INC_DWORD_STAT(STAT_FastAssetsRowWidgetsRecycled);
+		TSharedRef<SAssetListRow> Row = ListRowPool.Pop(EAllowShrinking::No);
+		Row->SetAssetItem(Item);
+		return Row;
+	}
+
+	return SNew(SAssetListRow, OwnerTable)
+		.AssetItem(Item)
+		.OnDragDetected(FOnAssetDragDetected::CreateSP(this, &SFastAssetsWindow::OnAssetDragDetected))
+		.OnPainted(FOnAssetRowPainted::CreateSP(this, &SFastAssetsWindow::OnAssetRowPainted));
+}
+
+void SFastAssetsWindow::OnAssetRowReleased(const TSharedRef<ITableRow>& Row)
+{
+	TSharedRef<SAssetListRow> ListRow = StaticCastSharedRef<SAssetListRow>(Row->AsWidget());
+
+	// Drop the item so pooled rows do not keep items from an old scan alive
+	ListRow->SetAssetItem(nullptr);
+	ListRowPool.Add(ListRow);
+}
+
+TSharedRef<ITableRow> SFastAssetsWindow::OnGenerateAssetTile(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if (TilePool.Num() > 0)
+	{
+		INC_DWORD_STAT(STAT_FastAssetsRowWidgetsRecycled);
+		TSharedRef<SAssetTile> Tile = TilePool.Pop(EAllowShrinking::No);
+		Tile->SetAssetItem(Item);
+		return Tile;
+	}
+
+	return SNew(SAssetTile, OwnerTable)
+		.AssetItem(Item)
+		.OnDragDetected(FOnAssetDragDetected::CreateSP(this, &SFastAssetsWindow::OnAssetDragDetected))
+		.OnPainted(FOnAssetRowPainted::CreateSP(this, &SFastAssetsWindow::OnAssetRowPainted));
+}
+
+void SFastAssetsWindow::OnAssetTileReleased(const TSharedRef<ITableRow>& Row)
+{
+	TSharedRef<SAssetTile> Tile = StaticCastSharedRef<SAssetTile>(Row->AsWidget());
+	Tile->SetAssetItem(nullptr);
+	TilePool.Add(Tile);
+}
+
+TSharedRef<ITableRow> SFastAssetsWindow::OnGenerateFolderRow(TSharedPtr<FFastAssetsFolderNode> Folder, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	TWeakPtr<FFastAssetsFolderNode> WeakFolder = Folder;
+
+	return SNew(STableRow<TSharedPtr<FFastAssetsFolderNode>>, OwnerTable)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(Folder->Name.IsEmpty() ? Folder->Path : Folder->Name))
+			]
+
+			// Totals move while a scan is running, so they are read from the folder each time
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(8.0f, 0.0f, 0.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				.Text_Lambda([WeakFolder]()
+				{
+					TSharedPtr<FFastAssetsFolderNode> Pinned = WeakFolder.Pin();
+					return Pinned.IsValid()
+						? FText::Format(LOCTEXT("FolderTotals", "{0} | {1}"), FText::AsNumber(Pinned->NumFiles), FText::FromString(FFastAssetsSharedCatalog::FormatFileSize(Pinned->TotalSize)))
+						: FText::GetEmpty();
+				})
+			]
+		];
+}
+
+void SFastAssetsWindow::OnGetFolderChildren(TSharedPtr<FFastAssetsFolderNode> Folder, TArray<TSharedPtr<FFastAssetsFolderNode>>& OutChildren)
+{
+	OutChildren = Folder->GetSortedChildren();
+}
+
+void SFastAssetsWindow::OnFolderSelectionChanged(TSharedPtr<FFastAssetsFolderNode> Folder, ESelectInfo::Type SelectInfo)
+{
+	// The root shows the whole scanned folder
+	const FString NewPrefix = Folder.IsValid() && Folder != FolderTreeRoots[0] ? Folder->Path + TEXT("/") : FString();
+	if (NewPrefix == FolderFilterPrefix)
 	{
-		StatusText->SetText(FText::Format(LOCTEXT("StatusScanning", "Scanning: {0}"), FText::FromString(Path)));
+		return;
 	}
 
-	// Supported extensions
-	TArray<FString> SupportedExtensions = {
-		// 3D Models
-		TEXT("fbx"), TEXT("obj"), TEXT("gltf"), TEXT("glb"), TEXT("usd"), TEXT("usda"), TEXT("usdc"), TEXT("abc"),
-		// Audio
-		TEXT("wav"), TEXT("mp3"), TEXT("ogg"), TEXT("flac"), TEXT("aiff"),
-		// Images/Textures
-		TEXT("png"), TEXT("jpg"), TEXT("jpeg"), TEXT("tga"), TEXT("bmp"), TEXT("exr"), TEXT("hdr"), TEXT("psd"), TEXT("tiff"),
-		// Unreal
-		TEXT("uasset"), TEXT("umap"),
-		// Data
-		TEXT("json"), TEXT("csv")
-	};
+	// Going into a subfolder can only drop items
+	const bool bNarrowing = NewPrefix.StartsWith(FolderFilterPrefix);
 
-	// Find all files recursively
-	TArray<FString> FoundFiles;
-	IFileManager::Get().FindFilesRecursive(FoundFiles, *Path, TEXT("*.*"), true, false);
+	FolderFilterPrefix = NewPrefix;
+	RefreshFilteredAssets(bNarrowing);
+}
 
-	for (const FString& FilePath : FoundFiles)
+void SFastAssetsWindow::OnAssetRowPainted(int32 IndexInList)
+{
+	PaintedIndexMin = PaintedIndexMin == INDEX_NONE ? IndexInList : FMath::Min(PaintedIndexMin, IndexInList);
+	PaintedIndexMax = PaintedIndexMax == INDEX_NONE ? IndexInList : FMath::Max(PaintedIndexMax, IndexInList);
+}
+
+void SFastAssetsWindow::UpdateThumbnailPrefetch()
+{
+	if (PaintedIndexMin == INDEX_NONE)
 	{
-		FString Extension = FPaths::GetExtension(FilePath).ToLower();
+		return;
+	}
 
-		if (SupportedExtensions.Contains(Extension))
+	if (LastFirstVisibleIndex != INDEX_NONE && PaintedIndexMin != LastFirstVisibleIndex)
+	{
+		ScrollDirection = PaintedIndexMin > LastFirstVisibleIndex ? 1 : -1;
+	}
+	LastFirstVisibleIndex = PaintedIndexMin;
+
+	// Prefetch one screen ahead in the direction of the last scroll; renewed every tick like visible requests
+	const int32 VisibleCount = PaintedIndexMax - PaintedIndexMin + 1;
+	const int32 PrefetchStart = ScrollDirection > 0 ? PaintedIndexMax + 1 : PaintedIndexMin - VisibleCount;
+	const int32 PrefetchEnd = FMath::Min(PrefetchStart + VisibleCount, GetNumFilteredAssets());
+
+	FFastAssetsThumbnail& Thumbnails = FFastAssetsThumbnail::Get();
+	const int32 ViewIndex = GetViewWidgetIndex();
+	const int32 Tier = ViewIndex == 1 ? SAssetListRow::GetThumbnailTier()
+		: ViewIndex == 2 ? SFastAssetsDenseGrid::GetThumbnailTier() : SAssetTile::GetThumbnailTier();
+	for (int32 Index = FMath::Max(PrefetchStart, 0); Index < PrefetchEnd; Index++)
+	{
+		const TSharedPtr<FExternalAssetItem> Item = GetFilteredAsset(Index);
+		if (Item.IsValid() && Item->ThumbnailBrushes[Tier] == nullptr)
 		{
-			TSharedPtr<FExternalAssetItem> NewItem = MakeShared<FExternalAssetItem>();
-			NewItem->FilePath = FilePath;
-			NewItem->FileName = FPaths::GetBaseFilename(FilePath);
-			NewItem->Extension = Extension;
-			NewItem->AssetType = DetermineAssetType(Extension);
-			NewItem->FileSize = IFileManager::Get().FileSize(*FilePath);
-			NewItem->ModifiedTime = IFileManager::Get().GetTimeStamp(*FilePath);
-			NewItem->ThumbnailBrush = nullptr; // Will be loaded on demand if needed
-
-			AllAssets.Add(NewItem);
+			Thumbnails.RequestThumbnail(Item, Tier, EFastAssetsThumbnailPriority::Prefetch);
 		}
 	}
 
-	RefreshFilteredAssets();
+	PaintedIndexMin = INDEX_NONE;
+	PaintedIndexMax = INDEX_NONE;
+}
+
+void SFastAssetsWindow::OnAssetSelectionChanged(TSharedPtr<FExternalAssetItem> Item, ESelectInfo::Type SelectInfo)
+{
+	SelectedAssets = GetSelectedAssets();
 
 	if (StatusText.IsValid())
 	{
 		StatusText->SetText(FText::Format(
-			LOCTEXT("StatusComplete", "{0} assets found | {1} selected | Drag to import"),
-			FText::AsNumber(FilteredAssets.Num()),
+			LOCTEXT("StatusWithSelection", "{0} assets found | {1} selected | Drag to import"),
+			FText::AsNumber(GetNumFilteredAssets()),
 			FText::AsNumber(SelectedAssets.Num())
 		));
 	}
 }
 
-void SFastAssetsWindow::ScanDirectoryAsync(const FString& Path)
+void SFastAssetsWindow::RefreshFilteredAssets(bool bOnlyNarrowing)
 {
-	// TODO: Implement async scanning for large directories
-	ScanDirectory(Path);
-}
+	if (!Catalog.IsValid())
+	{
+		return;
+	}
 
-FString SFastAssetsWindow::DetermineAssetType(const FString& Extension) const
-{
-	// 3D Models
-	if (Extension == TEXT("fbx") || Extension == TEXT("obj") ||
-		Extension == TEXT("gltf") || Extension == TEXT("glb") ||
-		Extension == TEXT("usd") || Extension == TEXT("usda") ||
-		Extension == TEXT("usdc") || Extension == TEXT("abc"))
+	// A catalog on disk stays on screen while it is being scanned again
+	if (TSharedPtr<FFastAssetsCatalog> DiskCatalog = Catalog->GetDiskCatalog())
 	{
-		return TEXT("Mesh");
+		RefreshCatalogView(DiskCatalog.ToSharedRef(), bOnlyNarrowing);
+		return;
 	}
 
-	// Audio
-	if (Extension == TEXT("wav") || Extension == TEXT("mp3") ||
-		Extension == TEXT("ogg") || Extension == TEXT("flac") ||
-		Extension == TEXT("aiff"))
+	if (CatalogItems.IsValid())
 	{
-		return TEXT("Sound");
+		SetCatalogItems(nullptr);
+		bOnlyNarrowing = false;
 	}
 
-	// Textures
-	if (Extension == TEXT("png") || Extension == TEXT("jpg") ||
-		Extension == TEXT("jpeg") || Extension == TEXT("tga") ||
-		Extension == TEXT("bmp") || Extension == TEXT("exr") ||
-		Extension == TEXT("hdr") || Extension == TEXT("psd") ||
-		Extension == TEXT("tiff"))
+	const TArray<TSharedPtr<FExternalAssetItem>>& Candidates = bOnlyNarrowing ? FilteredAssets : Catalog->GetAssets();
+
+	TArray<TSharedPtr<FExternalAssetItem>> NewFilteredAssets;
+	NewFilteredAssets.Reserve(Candidates.Num());
+	for (const TSharedPtr<FExternalAssetItem>& Item : Candidates)
 	{
-		return TEXT("Texture");
+		if (PassesFilter(Item))
+		{
+			NewFilteredAssets.Add(Item);
+		}
 	}
 
-	// Unreal Assets
-	if (Extension == TEXT("uasset"))
+	ApplyFilteredAssets(MoveTemp(NewFilteredAssets));
+}
+
+void SFastAssetsWindow::RefreshCatalogView(const TSharedRef<FFastAssetsCatalog>& DiskCatalog, bool bOnlyNarrowing)
+{
+	if (FilterCancelFlag.IsValid())
 	{
-		return TEXT("UAsset");
+		*FilterCancelFlag = true;
 	}
+	FFastAssetsCancelFlag CancelFlag = MakeShared<std::atomic<bool>, ESPMode::ThreadSafe>(false);
+	FilterCancelFlag = CancelFlag;
 
-	if (Extension == TEXT("umap"))
+	TSharedPtr<FFastAssetsCatalogView> BaseView;
+	if (bOnlyNarrowing && CatalogItems.IsValid() && CatalogItems->GetView()->GetCatalog() == DiskCatalog)
 	{
-		return TEXT("Map");
+		BaseView = CatalogItems->GetView();
 	}
 
-	// Data
-	if (Extension == TEXT("json") || Extension == TEXT("csv"))
+	// Whether the search matches a type or extension is decided once per type rather than per record
+	TArray<bool> TypeMatches;
+	for (const FString& Extension : FFastAssetsSharedCatalog::GetSupportedExtensions())
 	{
-		return TEXT("Data");
+		TypeMatches.Add(SearchText.IsEmpty() || Extension.Contains(SearchText, ESearchCase::IgnoreCase) ||
+			FFastAssetsSharedCatalog::DetermineAssetType(Extension).Contains(SearchText, ESearchCase::IgnoreCase));
 	}
 
-	return TEXT("Other");
+	TSharedRef<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> Applier = FFastAssetsUpdateApplier::GetShared();
+	TWeakPtr<SFastAssetsWindow> WeakWindow = SharedThis(this);
+
+	Async(EAsyncExecution::ThreadPool, [DiskCatalog, BaseView, Search = SearchText, Prefix = FolderFilterPrefix, TypeMatches = MoveTemp(TypeMatches), CancelFlag, WeakWindow, Applier]()
+	{
+		// Same rules as PassesFilter, read straight from the mapped records
+		TSharedPtr<FFastAssetsCatalogView> View = FFastAssetsCatalogView::Create(DiskCatalog, BaseView.Get(),
+			[&](const FFastAssetsCatalog::FRecord& Record, FStringView FilePath)
+			{
+				if (!Prefix.IsEmpty() && !FilePath.StartsWith(Prefix, ESearchCase::IgnoreCase))
+				{
+					return false;
+				}
+				return TypeMatches[Record.TypeIndex] || UE::String::FindFirst(FilePath.RightChop(Record.NameStart), Search, ESearchCase::IgnoreCase) != INDEX_NONE;
+			},
+			*CancelFlag);
+
+		if (!View.IsValid())
+		{
+			return;
+		}
+
+		Applier->EnqueueUpdate([View, CancelFlag, WeakWindow]()
+		{
+			TSharedPtr<SFastAssetsWindow> Window = WeakWindow.Pin();
+			if (Window.IsValid() && !*CancelFlag)
+			{
+				Window->ApplyCatalogView(View.ToSharedRef());
+			}
+		});
+	});
 }
 
-FString SFastAssetsWindow::FormatFileSize(int64 SizeInBytes) const
+void SFastAssetsWindow::ApplyCatalogView(const TSharedRef<FFastAssetsCatalogView>& View)
 {
-	if (SizeInBytes < 1024)
+	if (CatalogItems.IsValid() && CatalogItems->GetView()->GetCatalog() == View->GetCatalog())
 	{
-		return FString::Printf(TEXT("%lld B"), SizeInBytes);
+		CatalogItems->SetView(View);
 	}
-	else if (SizeInBytes < 1024 * 1024)
+	else
 	{
-		return FString::Printf(TEXT("%.1f KB"), SizeInBytes / 1024.0);
+		SetCatalogItems(MakeShared<FFastAssetsCatalogItemSource>(Catalog.ToSharedRef(), View));
 	}
-	else if (SizeInBytes < 1024 * 1024 * 1024)
+
+	RequestViewRefresh();
+}
+
+void SFastAssetsWindow::SetCatalogItems(const TSharedPtr<FFastAssetsCatalogItemSource>& Items)
+{
+	if (!Items.IsValid() && FilterCancelFlag.IsValid())
 	{
-		return FString::Printf(TEXT("%.1f MB"), SizeInBytes / (1024.0 * 1024.0));
+		*FilterCancelFlag = true;
 	}
-	else
+
+	CatalogItems = Items;
+	if (DenseGrid.IsValid())
 	{
-		return FString::Printf(TEXT("%.1f GB"), SizeInBytes / (1024.0 * 1024.0 * 1024.0));
+		DenseGrid->SetPagedItems(Items);
 	}
 }
 
-TSharedRef<ITableRow> SFastAssetsWindow::OnGenerateAssetRow(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+int32 SFastAssetsWindow::GetNumFilteredAssets() const
 {
-	return SNew(SAssetListRow, OwnerTable)
-		.AssetItem(Item)
-		.OnDragDetected(FOnAssetDragDetected::CreateSP(this, &SFastAssetsWindow::OnAssetDragDetected));
+	return CatalogItems.IsValid() ? CatalogItems->Num() : FilteredAssets.Num();
 }
 
-TSharedRef<ITableRow> SFastAssetsWindow::OnGenerateAssetTile(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable)
+TSharedPtr<FExternalAssetItem> SFastAssetsWindow::GetFilteredAsset(int32 Index) const
 {
-	return SNew(SAssetTile, OwnerTable)
-		.AssetItem(Item)
-		.OnDragDetected(FOnAssetDragDetected::CreateSP(this, &SFastAssetsWindow::OnAssetDragDetected));
+	return CatalogItems.IsValid() ? CatalogItems->GetItem(Index) : FilteredAssets[Index];
 }
 
-void SFastAssetsWindow::OnAssetSelectionChanged(TSharedPtr<FExternalAssetItem> Item, ESelectInfo::Type SelectInfo)
+int32 SFastAssetsWindow::FindBySortIndex(const TArray<TSharedPtr<FExternalAssetItem>>& Items, int32 SortIndex)
 {
-	SelectedAssets = GetSelectedAssets();
+	return Algo::LowerBoundBy(Items, SortIndex, [](const TSharedPtr<FExternalAssetItem>& Item) { return Item->SortIndex; });
+}
 
-	if (StatusText.IsValid())
+void SFastAssetsWindow::ApplyFilteredAssets(TArray<TSharedPtr<FExternalAssetItem>>&& NewFilteredAssets)
+{
+	// Find where the first visible item, or the one after it if it was filtered out, ends up
+	const int32 OldAnchorIndex = LastFirstVisibleIndex;
+	int32 NewAnchorIndex = INDEX_NONE;
+	if (FilteredAssets.IsValidIndex(OldAnchorIndex) && NewFilteredAssets.Num() > 0)
 	{
-		StatusText->SetText(FText::Format(
-			LOCTEXT("StatusWithSelection", "{0} assets found | {1} selected | Drag to import"),
-			FText::AsNumber(FilteredAssets.Num()),
-			FText::AsNumber(SelectedAssets.Num())
-		));
+		NewAnchorIndex = FMath::Min(FindBySortIndex(NewFilteredAssets, FilteredAssets[OldAnchorIndex]->SortIndex), NewFilteredAssets.Num() - 1);
 	}
+
+	// The views match rows to items by pointer, so rows of surviving items are kept and their selection with them
+	FilteredAssets = MoveTemp(NewFilteredAssets);
+
+	// Scroll by however many items were inserted or removed above the anchor, so it stays put on screen
+	if (NewAnchorIndex != INDEX_NONE && NewAnchorIndex != OldAnchorIndex)
+	{
+		const int32 Shift = NewAnchorIndex - OldAnchorIndex;
+		const int32 ViewIndex = GetViewWidgetIndex();
+		if (ViewIndex == 1 && AssetListView.IsValid())
+		{
+			AssetListView->SetScrollOffset(FMath::Max(AssetListView->GetScrollOffset() + Shift, 0.0f));
+		}
+		else if (ViewIndex == 2 && DenseGrid.IsValid())
+		{
+			DenseGrid->ShiftScrollAnchor(OldAnchorIndex, NewAnchorIndex);
+		}
+		else if (AssetTileView.IsValid())
+		{
+			// The tile view scrolls in rows, so shift by the rows the anchor moved across
+			const int32 ItemsPerLine = FMath::Max(AssetTileView->GetNumItemsPerLine(), 1);
+			const int32 RowShift = NewAnchorIndex / ItemsPerLine - OldAnchorIndex / ItemsPerLine;
+			AssetTileView->SetScrollOffset(FMath::Max(AssetTileView->GetScrollOffset() + RowShift, 0.0f));
+		}
+	}
+	LastFirstVisibleIndex = NewAnchorIndex;
+
+	RequestViewRefresh();
 }
 
-void SFastAssetsWindow::RefreshFilteredAssets()
+void SFastAssetsWindow::RequestViewRefresh()
 {
-	FilteredAssets.Empty();
+	// However many scan batches or filter changes land in a frame, the views refresh once
+	FFastAssetsUpdateApplier::Get().RequestRefresh(this, [this]()
+	{
+		RefreshViews();
+	});
+}
 
-	for (const TSharedPtr<FExternalAssetItem>& Item : AllAssets)
+void SFastAssetsWindow::RefreshViews()
+{
+	// The tree is shared, so each window compares against the version it last showed
+	if (FolderTreeView.IsValid() && Catalog.IsValid() && Catalog->GetFolderTree().GetStructureVersion() != FolderTreeVersion)
 	{
-		if (PassesFilter(Item))
+		FolderTreeVersion = Catalog->GetFolderTree().GetStructureVersion();
+		FolderTreeView->RequestTreeRefresh();
+
+		// A rescan removed the folder being shown
+		TArray<TSharedPtr<FFastAssetsFolderNode>> SelectedFolders = FolderTreeView->GetSelectedItems();
+		if (SelectedFolders.Num() > 0 && SelectedFolders[0] != FolderTreeRoots[0] && SelectedFolders[0]->Parent == nullptr)
 		{
-			FilteredAssets.Add(Item);
+			FolderTreeView->ClearSelection();
 		}
 	}
 
@@ -573,10 +990,45 @@ void SFastAssetsWindow::RefreshFilteredAssets()
 	{
 		AssetTileView->RequestListRefresh();
 	}
+
+	if (DenseGrid.IsValid())
+	{
+		DenseGrid->RequestRefresh();
+	}
+
+	UpdateStatusText();
+}
+
+void SFastAssetsWindow::UpdateStatusText()
+{
+	if (!StatusText.IsValid())
+	{
+		return;
+	}
+
+	if (Catalog.IsValid() && Catalog->IsScanning())
+	{
+		const int32 DiskScanProgress = Catalog->GetDiskScanProgress();
+		const int32 NumFound = DiskScanProgress != INDEX_NONE ? DiskScanProgress : GetNumFilteredAssets();
+		StatusText->SetText(FText::Format(LOCTEXT("StatusScanningCount", "Scanning: {0} | {1} assets found"), FText::FromString(Catalog->GetRootPath()), FText::AsNumber(NumFound)));
+	}
+	else
+	{
+		StatusText->SetText(FText::Format(
+			LOCTEXT("StatusComplete", "{0} assets found | {1} selected | Drag to import"),
+			FText::AsNumber(GetNumFilteredAssets()),
+			FText::AsNumber(SelectedAssets.Num())
+		));
+	}
 }
 
 bool SFastAssetsWindow::PassesFilter(const TSharedPtr<FExternalAssetItem>& Item) const
 {
+	if (!FolderFilterPrefix.IsEmpty() && !Item->FilePath.StartsWith(FolderFilterPrefix))
+	{
+		return false;
+	}
+
 	if (SearchText.IsEmpty())
 	{
 		return true;
@@ -608,15 +1060,41 @@ FReply SFastAssetsWindow::OnAssetDragDetected(TSharedPtr<FExternalAssetItem> Dra
 	return FReply::Unhandled();
 }
 
+bool SFastAssetsWindow::IsDenseGridEnabled() const
+{
+	return UFastAssetsSettings::Get()->bDenseGridView;
+}
+
+int32 SFastAssetsWindow::GetViewWidgetIndex() const
+{
+	// A catalog on disk is only shown by the dense grid, which pages its items in
+	if (CatalogItems.IsValid())
+	{
+		return 2;
+	}
+
+	if (CurrentViewMode == EFastAssetsViewMode::List)
+	{
+		return 1;
+	}
+
+	return IsDenseGridEnabled() ? 2 : 0;
+}
+
 TArray<TSharedPtr<FExternalAssetItem>> SFastAssetsWindow::GetSelectedAssets() const
 {
 	TArray<TSharedPtr<FExternalAssetItem>> Selected;
 
-	if (CurrentViewMode == EFastAssetsViewMode::List && AssetListView.IsValid())
+	const int32 ViewIndex = GetViewWidgetIndex();
+	if (ViewIndex == 1 && AssetListView.IsValid())
 	{
 		Selected = AssetListView->GetSelectedItems();
 	}
-	else if (CurrentViewMode == EFastAssetsViewMode::Grid && AssetTileView.IsValid())
+	else if (ViewIndex == 2 && DenseGrid.IsValid())
+	{
+		Selected = DenseGrid->GetSelectedItems();
+	}
+	else if (ViewIndex == 0 && AssetTileView.IsValid())
 	{
 		Selected = AssetTileView->GetSelectedItems();
 	}
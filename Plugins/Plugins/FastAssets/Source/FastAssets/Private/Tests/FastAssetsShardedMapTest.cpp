@@ -0,0 +1,97 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#include "FastAssetsShardedMap.h"
+#include "Misc/AutomationTest.h"
+#include "Async/Async.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFastAssetsShardedMapConcurrencyTest, "FastAssets.ShardedMap.Concurrency",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FFastAssetsShardedMapConcurrencyTest::RunTest(const FString& Parameters)
+{
+	static constexpr int32 NumThreads = 8;
+	static constexpr int32 KeysPerThread = 4000;
+
+	TFastAssetsShardedMap<int32> Map;
+
+	auto MakeKey = [](int32 Thread, int32 Index)
+	{
+		return FString::Printf(TEXT("C:/Assets/Thread%d/File%d.png"), Thread, Index);
+	};
+
+	// Every thread adds, reads back, updates and removes its own keys, reads other threads' keys
+	// and bumps one shared counter, all at the same time on dedicated threads
+	TArray<TFuture<int32>> Threads;
+	for (int32 Thread = 0; Thread < NumThreads; Thread++)
+	{
+		Threads.Add(Async(EAsyncExecution::Thread, [&Map, &MakeKey, Thread]()
+		{
+			int32 NumErrors = 0;
+			for (int32 Index = 0; Index < KeysPerThread; Index++)
+			{
+				const FString Key = MakeKey(Thread, Index);
+				Map.Add(Key, Index);
+
+				int32 Value = INDEX_NONE;
+				if (!Map.Find(Key.ToUpper(), Value) || Value != Index)
+				{
+					NumErrors++;
+				}
+
+				int32 OtherValue = 0;
+				Map.Find(MakeKey((Thread + 1) % NumThreads, Index), OtherValue);
+
+				Map.Update(TEXT("Shared"), [](int32& Count) { Count++; return true; });
+			}
+
+			for (int32 Index = 0; Index < KeysPerThread; Index++)
+			{
+				const FString Key = MakeKey(Thread, Index);
+				if (Index % 2 == 1)
+				{
+					NumErrors += Map.Remove(Key) ? 0 : 1;
+				}
+				else
+				{
+					Map.Update(Key, [](int32& Value) { Value += 1; return true; });
+				}
+			}
+			return NumErrors;
+		}));
+	}
+
+	int32 NumErrors = 0;
+	for (TFuture<int32>& Future : Threads)
+	{
+		NumErrors += Future.Get();
+	}
+	TestEqual(TEXT("Errors seen by the threads"), NumErrors, 0);
+
+	// Final contents: even keys bumped once, odd keys gone, the shared counter exact
+	TestEqual(TEXT("Entries left"), Map.Num(), NumThreads * KeysPerThread / 2 + 1);
+
+	int32 SharedCount = 0;
+	TestTrue(TEXT("Shared counter present"), Map.Find(TEXT("Shared"), SharedCount));
+	TestEqual(TEXT("Shared counter"), SharedCount, NumThreads * KeysPerThread);
+
+	int32 NumWrong = 0;
+	for (int32 Thread = 0; Thread < NumThreads; Thread++)
+	{
+		for (int32 Index = 0; Index < KeysPerThread; Index++)
+		{
+			int32 Value = INDEX_NONE;
+			const bool bFound = Map.Find(MakeKey(Thread, Index), Value);
+			if (Index % 2 == 1 ? bFound : (!bFound || Value != Index + 1))
+			{
+				NumWrong++;
+			}
+		}
+	}
+	TestEqual(TEXT("Keys with wrong final state"), NumWrong, 0);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
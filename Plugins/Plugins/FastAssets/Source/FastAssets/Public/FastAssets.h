@@ -10,6 +10,7 @@ class FMenuBuilder;
 class SDockTab;
 class FSpawnTabArgs;
 class FFastAssetsDropHandler;
+class FFastAssetsWarmUp;
 
 class FFastAssetsModule : public IModuleInterface
 {
@@ -21,19 +22,25 @@ public:
 	/** Opens the Fast Assets window */
 	void OpenFastAssetsWindow();
 
+	/** Opens another Fast Assets tab showing Path; tabs on the same folder share its scan */
+	void OpenNewFastAssetsTab(const FString& Path);
+
 	/** Get module instance */
 	static FFastAssetsModule& Get();
 
 	/** Check if module is loaded */
 	static bool IsAvailable();
 
-	/** Get the drop handler */
+	/** Get the drop handler, creating it on first use */
 	FFastAssetsDropHandler& GetDropHandler();
 
 private:
 	/** Register menus and toolbar buttons */
 	void RegisterMenus();
 
+	/** Create what only a session that opens the plugin needs, such as the drop handler and its level editor hooks */
+	void InitializeOnFirstUse();
+
 	/** Spawns the Fast Assets tab */
 	TSharedRef<SDockTab> OnSpawnFastAssetsTab(const FSpawnTabArgs& SpawnTabArgs);
 
@@ -44,6 +51,7 @@ private:
 	TSharedPtr<class FUICommandList> PluginCommands;
 	TSharedPtr<class SFastAssetsWindow> FastAssetsWindow;
 	TSharedPtr<FFastAssetsDropHandler> DropHandler;
+	TSharedPtr<FFastAssetsWarmUp> WarmUp;
 
 	/** Tab identifier */
 	static const FName FastAssetsTabName;
@@ -0,0 +1,41 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Waveform summary of a sound file, independent of the size it is drawn at.
+ *
+ * Each bucket covers an equal slice of the file and holds 4 bytes: the minimum and
+ * maximum sample mapped from [-1, 1] to [0, 255], the RMS mapped from [0, 1] to
+ * [0, 255] and a spare byte. The layout matches a row of BGRA8 texels so the
+ * thumbnail disk cache can store it as is.
+ */
+struct FFastAssetsWaveformPeaks
+{
+	TArray<uint8> Buckets;
+
+	int32 Num() const { return Buckets.Num() / 4; }
+};
+
+/**
+ * Streaming waveform thumbnails for sound files. Decoding happens in fixed-size chunks
+ * that are reduced to peaks as they arrive, so memory use does not grow with the file.
+ * All functions are thread safe.
+ */
+namespace FastAssetsAudioWaveform
+{
+	/** Number of buckets computed per file; enough for the largest thumbnail size */
+	constexpr int32 NumPeakBuckets = 1024;
+
+	/** Check if the extension is one we can decode (wav, aiff, and ogg where Vorbis is available) */
+	FASTASSETS_API bool IsSupportedExtension(const FString& Extension);
+
+	/** Stream-decode a sound file into peaks. Stops early and fails if CancelFlag is raised. */
+	FASTASSETS_API bool ComputePeaks(const FString& FilePath, const std::atomic<bool>& CancelFlag, FFastAssetsWaveformPeaks& OutPeaks);
+
+	/** Draw the peaks into a Width x Height BGRA8 image with a transparent background */
+	FASTASSETS_API void RenderWaveform(const FFastAssetsWaveformPeaks& Peaks, int32 Width, int32 Height, TArray<uint8>& OutPixels);
+}
@@ -0,0 +1,153 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include <atomic>
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Scan results of one folder kept on disk under Saved/FastAssets/Catalogs.
+ *
+ * Fixed-size records go to one file and their paths to another. Once the scan is written both are
+ * memory mapped, so the OS pages in only the records that are read and can drop them again under
+ * pressure; editor memory does not grow with the number of files. A catalog is immutable once
+ * written, so it can be read from any thread. Its files are deleted when it is destroyed.
+ */
+class FASTASSETS_API FFastAssetsCatalog
+{
+public:
+	struct FRecord
+	{
+		/** Characters into the paths file */
+		uint64 PathOffset = 0;
+		uint32 PathLength = 0;
+
+		/** Where the file name starts within the path */
+		uint32 NameStart = 0;
+
+		int64 FileSize = 0;
+		int64 ModifiedTicks = 0;
+
+		/** Caller-defined file type, such as an index into a list of extensions */
+		uint8 TypeIndex = 0;
+		uint8 Reserved[7] = {};
+	};
+
+	/** Writes a catalog as a scan finds files; use from one thread */
+	class FASTASSETS_API FWriter
+	{
+	public:
+		explicit FWriter(const FString& RootPath);
+		~FWriter();
+
+		void AddFile(FStringView FilePath, int64 FileSize, const FDateTime& ModifiedTime, uint8 TypeIndex);
+
+		int32 Num() const { return NumRecords; }
+
+		/** Write out the rest and map the files. Returns null if writing failed. */
+		TSharedPtr<FFastAssetsCatalog> Finish();
+
+	private:
+		void FlushPending();
+
+	private:
+		FString RecordsPath;
+		FString PathsPath;
+		TUniquePtr<IFileHandle> RecordsFile;
+		TUniquePtr<IFileHandle> PathsFile;
+
+		/** Written in large chunks rather than per file */
+		TArray<FRecord> PendingRecords;
+		TArray<TCHAR> PendingPaths;
+
+		uint64 NumPathChars = 0;
+		int32 NumRecords = 0;
+		bool bFailed = false;
+
+		static constexpr int32 FlushRecords = 16384;
+	};
+
+	~FFastAssetsCatalog();
+
+	int32 Num() const { return NumRecords; }
+	const FRecord& GetRecord(int32 Index) const { return Records[Index]; }
+
+	FStringView GetPath(const FRecord& Record) const { return FStringView(Paths + Record.PathOffset, Record.PathLength); }
+	FStringView GetFileName(const FRecord& Record) const { return GetPath(Record).RightChop(Record.NameStart); }
+
+	static FString GetCatalogDirectory();
+
+private:
+	/** A read-only mapping of a file this session wrote */
+	struct FMappedFile
+	{
+		FString FilePath;
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+
+		/** Map the file; an empty file maps to no data */
+		bool Map(const FString& InFilePath);
+
+		/** Unmap and delete the file */
+		void Release();
+	};
+
+	FFastAssetsCatalog() = default;
+
+	/** Files left behind by a session that did not shut down cleanly */
+	static void DeleteStaleFiles();
+
+private:
+	FMappedFile RecordsMapping;
+	FMappedFile PathsMapping;
+
+	const FRecord* Records = nullptr;
+	const TCHAR* Paths = nullptr;
+	int32 NumRecords = 0;
+
+	friend class FFastAssetsCatalogView;
+};
+
+/**
+ * Indices of the catalog records that passed a filter, in catalog order.
+ *
+ * The indices are written to a file and mapped like the catalog, so a result of millions of records
+ * costs no editor memory either. Immutable once created; the file is deleted with the view.
+ */
+class FASTASSETS_API FFastAssetsCatalogView
+{
+public:
+	typedef TFunctionRef<bool(const FFastAssetsCatalog::FRecord&, FStringView)> FPredicate;
+
+	/**
+	 * Run Predicate(Record, Path) over the records of InCatalog, or only over those in BaseView when given.
+	 * Returns null if cancelled or the result could not be written.
+	 */
+	static TSharedPtr<FFastAssetsCatalogView> Create(const TSharedRef<FFastAssetsCatalog>& InCatalog, const FFastAssetsCatalogView* BaseView, FPredicate Predicate, const std::atomic<bool>& CancelFlag);
+
+	~FFastAssetsCatalogView();
+
+	int32 Num() const { return NumIndices; }
+	int32 GetRecordIndex(int32 Index) const { return (int32)Indices[Index]; }
+
+	/** Position of a record in this view, or INDEX_NONE if it did not pass the filter */
+	int32 Find(int32 RecordIndex) const;
+
+	const TSharedRef<FFastAssetsCatalog>& GetCatalog() const { return Catalog; }
+
+private:
+	explicit FFastAssetsCatalogView(const TSharedRef<FFastAssetsCatalog>& InCatalog) : Catalog(InCatalog) {}
+
+private:
+	TSharedRef<FFastAssetsCatalog> Catalog;
+	FFastAssetsCatalog::FMappedFile Mapping;
+	const uint32* Indices = nullptr;
+	int32 NumIndices = 0;
+};
@@ -0,0 +1,68 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One folder under the scanned root, with totals for everything below it */
+struct FFastAssetsFolderNode
+{
+	FString Name;
+
+	/** Built like the scanned file paths, so a file is in this folder if its path starts with Path + "/" */
+	FString Path;
+
+	/** Cleared when the node is removed from the tree */
+	FFastAssetsFolderNode* Parent = nullptr;
+
+	/** Files in this folder and all folders below it */
+	int32 NumFiles = 0;
+	int64 TotalSize = 0;
+
+	/** Subfolders by name */
+	TMap<FString, TSharedPtr<FFastAssetsFolderNode>> Children;
+
+	/** Subfolders sorted by name, built the first time they are shown after a subfolder was added or removed */
+	const TArray<TSharedPtr<FFastAssetsFolderNode>>& GetSortedChildren();
+
+private:
+	TArray<TSharedPtr<FFastAssetsFolderNode>> SortedChildren;
+	bool bSortedChildrenDirty = false;
+
+	friend class FFastAssetsFolderTree;
+};
+
+/**
+ * Folders of a scanned root with per-folder file counts and sizes.
+ *
+ * Built from the scanned files as they arrive: adding or removing a file creates or drops the folders
+ * on its path and updates the totals of each folder up to the root, so no totals are ever recomputed by
+ * walking the tree. Subfolder lists are only sorted when a tree view expands the folder.
+ */
+class FASTASSETS_API FFastAssetsFolderTree
+{
+public:
+	FFastAssetsFolderTree();
+
+	/** Drop all folders and start over at RootPath */
+	void Reset(const FString& RootPath);
+
+	/** Count a file, creating the folders on its path as needed */
+	void AddFile(const FString& FilePath, int64 FileSize);
+
+	/** Uncount a file added earlier, dropping folders that end up empty */
+	void RemoveFile(const FString& FilePath, int64 FileSize);
+
+	TSharedPtr<FFastAssetsFolderNode> GetRoot() const { return Root; }
+
+	/** Changes whenever folders are added or removed, so each view can tell when to refresh */
+	uint32 GetStructureVersion() const { return StructureVersion; }
+
+private:
+	/** Folder holding FilePath, or nullptr if it is not under the root or missing and bCreate is false */
+	FFastAssetsFolderNode* FindFolder(const FString& FilePath, bool bCreate);
+
+private:
+	TSharedPtr<FFastAssetsFolderNode> Root;
+	uint32 StructureVersion = 0;
+};
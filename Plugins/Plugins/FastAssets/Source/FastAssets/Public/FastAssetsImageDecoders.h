@@ -0,0 +1,53 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16Color.h"
+
+class IImageWrapperModule;
+
+/**
+ * Format-specific fast paths used by the thumbnail workers to avoid decoding a large
+ * image at full resolution. Every function is thread safe, produces tightly packed
+ * pixels and returns false when the caller should fall back to a full decode.
+ */
+namespace FastAssetsImageDecoders
+{
+	/** Bytes from the start of a JPEG that are read first; enough for the APP segments holding EXIF */
+	constexpr int64 JpegHeadBytes = 128 * 1024;
+
+	/**
+	 * Decode the EXIF thumbnail embedded in a JPEG. Data may be just the head of the file.
+	 * Fails unless the thumbnail covers MaxSize on its long edge and matches the aspect ratio
+	 * of the main image, so letterboxed or tiny camera previews are never used.
+	 */
+	FASTASSETS_API bool DecodeExifThumbnail(IImageWrapperModule& WrapperModule, const uint8* Data, int64 Size, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/**
+	 * Decode a JPEG with DCT scaling (1/2, 1/4 or 1/8) to the smallest size that still covers
+	 * MaxSize, skipping most of the IDCT work. Fails if scaled decoding is not available.
+	 */
+	FASTASSETS_API bool DecodeJpegScaled(const uint8* Data, int64 Size, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/**
+	 * Read a reduced copy of an OpenEXR file that still covers MaxSize: the smallest such
+	 * mip level of a tiled file, otherwise every Nth scanline and pixel. Only the compressed
+	 * blocks holding those lines are decoded. Multi-part files use their first part.
+	 * Produces linear half float RGBA instead of BGRA8, ready for tone mapping.
+	 */
+	FASTASSETS_API bool DecodeExrReduced(const FString& FilePath, int32 MaxSize, TArray<FFloat16Color>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/**
+	 * Read the flattened composite of a Photoshop PSD or PSB without touching its layers.
+	 * Uses the embedded preview when it covers MaxSize; otherwise only every Nth row of the
+	 * composite is read, located through the RLE row table. 8 and 16-bit RGB or grayscale only.
+	 */
+	FASTASSETS_API bool DecodePsdComposite(IImageWrapperModule& WrapperModule, const FString& FilePath, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/**
+	 * Decode the smallest image in a TIFF that still covers MaxSize: the first IFD or one of
+	 * its reduced-resolution subfiles. Only the strips or tiles holding sampled rows are decoded.
+	 */
+	FASTASSETS_API bool DecodeTiffReduced(const FString& FilePath, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+}
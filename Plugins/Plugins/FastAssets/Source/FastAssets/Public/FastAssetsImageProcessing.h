@@ -0,0 +1,36 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Float16Color.h"
+
+/**
+ * CPU image helpers used by the thumbnail workers. All functions are thread safe
+ * and produce tightly packed BGRA8 buffers.
+ */
+namespace FastAssetsImageProcessing
+{
+	/** Size of Width x Height scaled to fit inside a MaxSize square, keeping aspect ratio. Never upscales. */
+	FASTASSETS_API FIntPoint FitWithin(int32 Width, int32 Height, int32 MaxSize);
+
+	/**
+	 * Area-filter a BGRA8 image down to DstWidth x DstHeight. Every source pixel contributes
+	 * by the fraction of its footprint that falls into a destination pixel, with alpha
+	 * premultiplied so transparent pixels do not bleed their color.
+	 */
+	FASTASSETS_API void DownscaleBGRA8(const uint8* Src, int32 SrcWidth, int32 SrcHeight, uint8* Dst, int32 DstWidth, int32 DstHeight);
+
+	/** Downscale Pixels in place so the image fits inside MaxSize. Returns false if it was already small enough. */
+	FASTASSETS_API bool ShrinkToFit(TArray<uint8>& Pixels, int32& Width, int32& Height, int32 MaxSize);
+
+	/**
+	 * Make an sRGB BGRA8 thumbnail from linear half float RGBA pixels. The image is reduced to fit
+	 * MaxSize in linear light first, sampling a few source pixels per thumbnail pixel, then tone
+	 * mapped with an exposure picked from its average luminance so HDR values are not clipped.
+	 */
+	FASTASSETS_API void ToneMapHalf(const FFloat16Color* Src, int32 SrcWidth, int32 SrcHeight, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/** Same as ToneMapHalf for 32-bit float RGBA pixels */
+	FASTASSETS_API void ToneMapFloat(const FLinearColor* Src, int32 SrcWidth, int32 SrcHeight, int32 MaxSize, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+}
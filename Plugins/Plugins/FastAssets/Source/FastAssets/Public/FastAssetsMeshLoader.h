@@ -0,0 +1,40 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Triangle soup in world space, enough to draw a mesh thumbnail
+ */
+struct FFastAssetsMeshData
+{
+	TArray<FVector3f> Positions;
+
+	/** Three indices into Positions per triangle */
+	TArray<uint32> Indices;
+
+	int32 NumTriangles() const { return Indices.Num() / 3; }
+};
+
+/**
+ * Minimal geometry readers for mesh thumbnails. Only positions and triangles are read;
+ * materials, normals and UVs are ignored. All functions are thread safe.
+ *
+ * Meshes with more than MaxTriangles triangles keep an evenly spaced subset of them,
+ * so a huge scan cannot hold a worker for long.
+ */
+namespace FastAssetsMeshLoader
+{
+	/** Check if the extension is one we can read (obj, gltf, glb) */
+	FASTASSETS_API bool IsSupportedExtension(const FString& Extension);
+
+	/** Load a mesh file, picking the reader by extension */
+	FASTASSETS_API bool LoadMesh(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh);
+
+	/** Wavefront OBJ, polygons are fan triangulated */
+	FASTASSETS_API bool LoadObj(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh);
+
+	/** glTF 2.0, either .gltf with external or embedded buffers, or binary .glb. Node transforms are applied. */
+	FASTASSETS_API bool LoadGltf(const FString& FilePath, int32 MaxTriangles, FFastAssetsMeshData& OutMesh);
+}
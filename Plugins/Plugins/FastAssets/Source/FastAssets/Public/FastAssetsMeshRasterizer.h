@@ -0,0 +1,20 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFastAssetsMeshData;
+
+/**
+ * Software renderer for mesh thumbnails. Runs entirely on the CPU and never touches
+ * the RHI, so it works on worker threads and under -nullrhi.
+ */
+namespace FastAssetsMeshRasterizer
+{
+	/**
+	 * Render a flat shaded, depth tested view of the mesh from a fixed three-quarter angle,
+	 * framed to its bounds, into a Size x Size BGRA8 image with a transparent background.
+	 */
+	FASTASSETS_API bool RenderThumbnail(const FFastAssetsMeshData& Mesh, int32 Size, TArray<uint8>& OutPixels);
+}
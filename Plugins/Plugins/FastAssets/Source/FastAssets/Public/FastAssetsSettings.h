@@ -150,10 +150,61 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = "Scanning", meta = (DisplayName = "Exclude Extensions"))
 	TArray<FString> ExcludeExtensions;
 
+	// ========== Performance Settings ==========
+
+	/** Memory budget for cached thumbnails; the least recently used ones are released beyond it */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Thumbnail Cache Budget (MB)", ClampMin = "16", ClampMax = "4096"))
+	int32 ThumbnailCacheBudgetMB;
+
+	/** Keep scaled thumbnails on disk (Saved/FastAssets) so later sessions skip decoding */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Disk Thumbnail Cache"))
+	bool bEnableDiskThumbnailCache;
+
+	/** Maximum size of the disk thumbnail cache; the oldest packs are deleted beyond it */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Disk Thumbnail Cache Size (MB)", ClampMin = "64", ClampMax = "65536", EditCondition = "bEnableDiskThumbnailCache"))
+	int32 DiskThumbnailCacheMaxMB;
+
+	/** Decode images and meshes in helper processes, so a malformed file cannot crash the editor or bloat its heap */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Decode Thumbnails Out Of Process"))
+	bool bDecodeThumbnailsOutOfProcess;
+
+	/** Number of helper processes; each one is a headless editor instance */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Thumbnail Helper Processes", ClampMin = "1", ClampMax = "16", EditCondition = "bDecodeThumbnailsOutOfProcess"))
+	int32 ThumbnailHelperProcesses;
+
+	/** Game thread time per frame for applying scan results and thumbnail uploads; the rest waits for the next frame */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Main Thread Budget (ms)", ClampMin = "0.5", ClampMax = "16.0"))
+	float MainThreadBudgetMs;
+
+	/** Draw the grid as a single widget with half size tiles, so thousands of files fit on screen at full frame rate */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Dense Grid View"))
+	bool bDenseGridView;
+
+	/** Keep scan results in memory mapped files instead of the editor heap, for folders with millions of files; shows the dense grid */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Keep Catalog On Disk"))
+	bool bKeepCatalogOnDisk;
+
+	/** Once the editor has started, scan the most recent folders and decode their first thumbnails in the background */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Warm Up Recent Paths"))
+	bool bWarmUpRecentPaths;
+
+	/** Number of recent folders to warm up; their scan results stay in memory for the session */
+	UPROPERTY(config, EditAnywhere, Category = "Performance", meta = (DisplayName = "Recent Paths To Warm Up", ClampMin = "1", ClampMax = "10", EditCondition = "bWarmUpRecentPaths"))
+	int32 WarmUpRecentPathsCount;
+
 public:
 	/** Get thumbnail size in pixels */
 	int32 GetThumbnailSizePixels() const;
 
+	/** Get the per-frame game thread budget for applying background results */
+	double GetMainThreadBudgetSeconds() const;
+
+	/** Get the thumbnail cache budget in bytes */
+	int64 GetThumbnailCacheBudgetBytes() const;
+
+	/** Get the disk thumbnail cache budget in bytes */
+	int64 GetDiskThumbnailCacheBudgetBytes() const;
+
 	/** Add a path to recent paths */
 	void AddRecentPath(const FString& Path);
 
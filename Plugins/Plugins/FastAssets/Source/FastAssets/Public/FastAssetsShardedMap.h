@@ -0,0 +1,111 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+/**
+ * File path keyed map that can be used from any thread.
+ *
+ * Keys are spread over NumShards independent maps, each behind its own reader/writer lock on
+ * its own cache line. Lookups take a shared lock on one shard only, so readers never block each
+ * other and a writer only stalls the paths that hash to its shard. Keys compare like FString,
+ * ignoring case.
+ */
+template<typename ValueType, int32 NumShards = 16>
+class TFastAssetsShardedMap
+{
+public:
+	/** Copy the value for Key into OutValue. Returns false if the key is not present. */
+	bool Find(const FString& Key, ValueType& OutValue) const
+	{
+		const FShard& Shard = GetShard(Key);
+		FReadScopeLock ReadLock(Shard.Lock);
+
+		if (const ValueType* Value = Shard.Map.Find(Key))
+		{
+			OutValue = *Value;
+			return true;
+		}
+		return false;
+	}
+
+	bool Contains(const FString& Key) const
+	{
+		const FShard& Shard = GetShard(Key);
+		FReadScopeLock ReadLock(Shard.Lock);
+		return Shard.Map.Contains(Key);
+	}
+
+	/** Add or replace the value for Key */
+	void Add(const FString& Key, const ValueType& Value)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock WriteLock(Shard.Lock);
+		Shard.Map.Add(Key, Value);
+	}
+
+	/**
+	 * Run Functor(ValueType&) on the value for Key, default constructing it first if it is missing.
+	 * The entry is removed if the functor returns false. The shard stays locked while it runs.
+	 */
+	template<typename FunctorType>
+	void Update(const FString& Key, FunctorType&& Functor)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock WriteLock(Shard.Lock);
+
+		if (!Functor(Shard.Map.FindOrAdd(Key)))
+		{
+			Shard.Map.Remove(Key);
+		}
+	}
+
+	/** Returns true if the key was present */
+	bool Remove(const FString& Key)
+	{
+		FShard& Shard = GetShard(Key);
+		FWriteScopeLock WriteLock(Shard.Lock);
+		return Shard.Map.Remove(Key) > 0;
+	}
+
+	void Empty()
+	{
+		for (FShard& Shard : Shards)
+		{
+			FWriteScopeLock WriteLock(Shard.Lock);
+			Shard.Map.Empty();
+		}
+	}
+
+	/** Number of entries; only a snapshot while other threads are writing */
+	int32 Num() const
+	{
+		int32 Count = 0;
+		for (const FShard& Shard : Shards)
+		{
+			FReadScopeLock ReadLock(Shard.Lock);
+			Count += Shard.Map.Num();
+		}
+		return Count;
+	}
+
+private:
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TMap<FString, ValueType> Map;
+	};
+
+	static uint32 GetShardIndex(const FString& Key)
+	{
+		// Same case-insensitive hash TMap uses, so keys that compare equal land in the same shard
+		return GetTypeHash(Key) % NumShards;
+	}
+
+	FShard& GetShard(const FString& Key) { return Shards[GetShardIndex(Key)]; }
+	const FShard& GetShard(const FString& Key) const { return Shards[GetShardIndex(Key)]; }
+
+	FShard Shards[NumShards];
+};
@@ -0,0 +1,126 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SFastAssetsWindow.h"
+#include "FastAssetsFolderTree.h"
+#include <atomic>
+
+class FFastAssetsCatalog;
+
+/**
+ * Scanned assets of one folder, shared by every window that shows it.
+ *
+ * Windows get the catalog for their folder from Get() and it lives as long as one of them holds it.
+ * The folder is scanned once however many windows show it; rescans, the folder tree and the items
+ * themselves (and with them their thumbnails) are shared too, and each window only keeps its own
+ * filtered view. Game thread only.
+ */
+class FASTASSETS_API FFastAssetsSharedCatalog : public TSharedFromThis<FFastAssetsSharedCatalog>
+{
+public:
+	/** Broadcast with the index of the first appended asset, or INDEX_NONE when any asset may have changed */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnChanged, int32);
+
+	/** The catalog for RootPath, created empty if no window holds one */
+	static TSharedRef<FFastAssetsSharedCatalog> Get(const FString& RootPath);
+
+	~FFastAssetsSharedCatalog();
+
+	/** Scan the folder unless that has already been done or started */
+	void EnsureScanned();
+
+	/** Scan the folder again; assets of unchanged files are kept */
+	void Rescan();
+
+	const FString& GetRootPath() const { return RootPath; }
+	bool IsScanning() const { return bScanning; }
+
+	/** Files written so far by a scan into a catalog on disk, or INDEX_NONE when not scanning to disk */
+	int32 GetDiskScanProgress() const { return bScanningToDisk ? DiskScanProgress : INDEX_NONE; }
+
+	/** Assets in scan order, when scanned into memory */
+	const TArray<TSharedPtr<FExternalAssetItem>>& GetAssets() const { return Assets; }
+
+	/** Scan results on disk, when the catalog is kept on disk */
+	TSharedPtr<FFastAssetsCatalog> GetDiskCatalog() const { return DiskCatalog; }
+
+	/** Item for a record of FromCatalog; built on first use and shared while anything holds it if FromCatalog is the current one */
+	TSharedPtr<FExternalAssetItem> GetDiskItem(const TSharedRef<FFastAssetsCatalog>& FromCatalog, int32 RecordIndex);
+
+	/** Whether Item was built by GetDiskItem for the current catalog on disk */
+	bool IsDiskItem(const FExternalAssetItem& Item) const;
+
+	const FFastAssetsFolderTree& GetFolderTree() const { return FolderTree; }
+
+	FOnChanged& OnChanged() { return OnChangedDelegate; }
+
+	/** Build an item with its display text; safe on worker threads */
+	static TSharedPtr<FExternalAssetItem> MakeAssetItem(const FString& FilePath, const FString& Extension);
+	static TSharedPtr<FExternalAssetItem> MakeAssetItem(const FString& FilePath, const FString& Extension, int64 FileSize, const FDateTime& ModifiedTime);
+
+	/** Lower case extensions a scan picks up */
+	static const TArray<FString>& GetSupportedExtensions();
+
+	/** Index into GetSupportedExtensions(), or INDEX_NONE if the extension is not supported */
+	static int32 GetSupportedExtensionIndex(const FString& Extension);
+
+	static FString DetermineAssetType(const FString& Extension);
+	static FString FormatFileSize(int64 SizeInBytes);
+
+private:
+	explicit FFastAssetsSharedCatalog(const FString& InRootPath);
+
+	/** Scan on a worker thread; results arrive in batches through the update applier */
+	void StartScan();
+	void AddScannedAssets(TArray<TSharedPtr<FExternalAssetItem>>&& Items, bool bScanFinished);
+
+	/** Replace Assets with a finished rescan, reusing the items of unchanged files */
+	void ApplyRescan();
+
+	/** A scan into a catalog on disk finished; Catalog is null if it could not be written */
+	void OnDiskScanned(const TSharedPtr<FFastAssetsCatalog>& Catalog, FFastAssetsFolderTree&& ScannedFolders);
+
+private:
+	FString RootPath;
+
+	TArray<TSharedPtr<FExternalAssetItem>> Assets;
+
+	// Folders of RootPath with their file counts and sizes, updated as assets are added and removed
+	FFastAssetsFolderTree FolderTree;
+
+	// Set to stop the running scan and drop its remaining batches
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> ScanCancelFlag;
+	bool bScanStarted = false;
+	bool bScanning = false;
+
+	// A rescan collects its results here and swaps them in once complete
+	bool bRescanning = false;
+	TArray<TSharedPtr<FExternalAssetItem>> RescannedAssets;
+
+	TSharedPtr<FFastAssetsCatalog> DiskCatalog;
+	bool bScanningToDisk = false;
+	int32 DiskScanProgress = 0;
+
+	// Items built from DiskCatalog by record index; one that is still selected or loading a thumbnail is handed out again
+	TMap<int32, TWeakPtr<FExternalAssetItem>> DiskItems;
+	int32 PruneDiskItemsAt = MaxRecentDiskItems * 2;
+
+	// Ring of the most recently built disk items, so scrolling back and forth does not rebuild them
+	TArray<TSharedPtr<FExternalAssetItem>> RecentDiskItems;
+	int32 NextRecentDiskItem = 0;
+
+	FOnChanged OnChangedDelegate;
+
+	// Items handed to the game thread per scan update
+	static constexpr int32 ScanBatchSize = 512;
+
+	// Files a scan to disk writes between progress updates
+	static constexpr int32 DiskProgressInterval = 65536;
+
+	static constexpr int32 MaxRecentDiskItems = 4096;
+
+	// Catalogs by normalized root path, alive while a window holds them
+	static TMap<FString, TWeakPtr<FFastAssetsSharedCatalog>> Catalogs;
+};
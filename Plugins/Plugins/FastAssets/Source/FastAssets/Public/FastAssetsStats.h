@@ -0,0 +1,9 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/** Counters shown by "stat FastAssets" */
+DECLARE_STATS_GROUP(TEXT("FastAssets"), STATGROUP_FastAssets, STATCAT_Advanced);
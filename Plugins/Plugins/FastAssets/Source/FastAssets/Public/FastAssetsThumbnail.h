@@ -3,12 +3,76 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include <atomic>
 #include "Styling/SlateBrush.h"
+#include "FastAssetsThumbnailAtlas.h"
+#include "FastAssetsThumbnailScheduler.h"
+#include "FastAssetsShardedMap.h"
 
-class UTexture2D;
+class IImageWrapperModule;
+class FFastAssetsThumbnailDiskCache;
+class FFastAssetsWorkerProcessPool;
+struct FExternalAssetItem;
 
 /**
- * Manages thumbnail loading and caching for external assets
+ * Resolution tiers every thumbnail is kept at. Each view draws from the smallest tier
+ * that covers it, so list icons never sample a grid-sized image.
+ */
+namespace FastAssetsThumbnailTier
+{
+	constexpr int32 Num = 4;
+
+	/** Edge length of a tier in pixels: 32, 64, 128 or 256 */
+	constexpr int32 GetSize(int32 Tier) { return 32 << Tier; }
+
+	/** Smallest tier that covers DrawSize pixels (the largest tier if none does) */
+	FASTASSETS_API int32 ForSize(int32 DrawSize);
+}
+
+/**
+ * Pixel data decoded on a worker thread, waiting to be uploaded on the game thread
+ */
+struct FFastAssetsDecodedThumbnail
+{
+	/** One tier of the thumbnail */
+	struct FTier
+	{
+		int32 Width = 0;
+		int32 Height = 0;
+		TArray<uint8> Pixels;
+	};
+
+	FString FilePath;
+	int32 Width = 0;
+	int32 Height = 0;
+
+	/** BGRA8 pixels as decoded, fitting the largest tier; moved into Tiers before the hand-off */
+	TArray<uint8> Pixels;
+
+	/** BGRA8 pixels of every tier, smallest first; empty if the file could not be decoded */
+	TArray<FTier, TInlineAllocator<FastAssetsThumbnailTier::Num>> Tiers;
+
+	/** The request went stale and the worker stopped early; not a decode failure */
+	bool bCancelled = false;
+};
+
+/**
+ * What the cache knows about a file, kept where any thread can read it
+ */
+struct FFastAssetsThumbnailStatus
+{
+	/** Bit per tier uploaded to an atlas */
+	uint8 ResidentTiers = 0;
+
+	/** The file could not be decoded and is not retried */
+	bool bFailed = false;
+};
+
+/**
+ * Manages thumbnail loading and caching for external assets.
+ * Brushes and atlases belong to the game thread; the status queries are safe from any thread.
  */
 class FASTASSETS_API FFastAssetsThumbnail
 {
@@ -19,37 +83,200 @@ public:
 	/** Get singleton instance */
 	static FFastAssetsThumbnail& Get();
 
-	/** Load or get cached thumbnail for an asset */
+	/** Destroy the singleton instance (called on module shutdown) */
+	static void Shutdown();
+
+	/** Get a cached thumbnail, or the asset type icon while the thumbnail is decoded in the background */
 	const FSlateBrush* GetThumbnailBrush(const FString& FilePath, const FString& AssetType);
 
+	/**
+	 * Request one tier of the thumbnail for an asset item. Returns the cached brush if it is ready,
+	 * otherwise schedules a background decode and fills in Item->ThumbnailBrushes once uploaded.
+	 * Visible and prefetch requests must be repeated every frame or they are cancelled.
+	 */
+	const FSlateBrush* RequestThumbnail(const TSharedPtr<FExternalAssetItem>& Item, int32 Tier, EFastAssetsThumbnailPriority Priority = EFastAssetsThumbnailPriority::Visible);
+
+	/** Tier grid tiles draw at, from the thumbnail size setting */
+	static int32 GetGridTier();
+
 	/** Get icon brush for asset type (for non-previewable assets) */
 	const FSlateBrush* GetAssetTypeIcon(const FString& AssetType);
 
 	/** Check if asset type supports image thumbnail */
 	bool SupportsImageThumbnail(const FString& AssetType) const;
 
+	/** Check if we can draw a thumbnail for the file: images, plus meshes and sounds in a format we can read */
+	bool SupportsThumbnail(const FString& FilePath, const FString& AssetType) const;
+
+	/** Check if a tier of the file's thumbnail is uploaded (any thread) */
+	bool IsThumbnailCached(const FString& FilePath, int32 Tier) const;
+
+	/** Check if the file failed to decode (any thread) */
+	bool HasThumbnailFailed(const FString& FilePath) const;
+
 	/** Clear thumbnail cache */
 	void ClearCache();
 
-	/** Pre-cache thumbnails for a list of files */
+	/** Release least recently used thumbnails until the cache fits in BudgetBytes */
+	void TrimCache(int64 BudgetBytes);
+
+	/** Memory currently held by atlas pages of every tier */
+	int64 GetCacheSizeBytes() const;
+
+	/** Queue background decodes for a list of files */
 	void PreCacheThumbnails(const TArray<FString>& FilePaths, const TArray<FString>& AssetTypes);
 
+	/** Decode a file on the calling thread without touching the cache; used by the thumbnail helper processes */
+	static bool DecodeStandalone(const FString& FilePath, int32 MaxSize, FFastAssetsDecodedThumbnail& OutDecoded);
+
 private:
-	/** Load image file as brush */
-	TSharedPtr<FSlateBrush> LoadImageAsBrush(const FString& FilePath);
+	typedef TQueue<FFastAssetsDecodedThumbnail, EQueueMode::Mpsc> FDecodedThumbnailQueue;
+
+	/** A cached thumbnail, resident at one or more tiers, and the items that point at its brushes */
+	struct FCacheEntry
+	{
+		/** Brush per tier, null for tiers that are not resident */
+		TSharedPtr<FSlateBrush> Brushes[FastAssetsThumbnailTier::Num];
+
+		/** Where each tier lives in that tier's atlas */
+		FFastAssetsAtlasSlot Slots[FastAssetsThumbnailTier::Num];
+
+		/** Items whose ThumbnailBrushes point at Brushes, cleared on eviction */
+		TArray<TWeakPtr<FExternalAssetItem>> Owners;
+
+		bool HasAnyTier() const;
+	};
+
+	/** An atlas page of one tier */
+	struct FTierPage
+	{
+		int32 Tier = 0;
+		int32 Page = INDEX_NONE;
+	};
+
+	/** Find a cached entry holding Tier and mark that tier's atlas page as most recently used */
+	FCacheEntry* FindAndTouch(const FString& FilePath, int32 Tier);
 
-	/** Create texture from image data */
-	UTexture2D* CreateTextureFromImage(const FString& FilePath);
+	/** Add Item to the owners of Entry and point it at every resident tier */
+	void AssignToItem(FCacheEntry& Entry, const TSharedPtr<FExternalAssetItem>& Item);
+
+	/** True if an owning widget drew this tier of the thumbnail in the last couple of frames */
+	bool IsOnScreen(const FCacheEntry& Entry, int32 Tier) const;
+
+	/** True if any thumbnail on the atlas page is on screen */
+	bool IsPageOnScreen(const FTierPage& Page) const;
+
+	/** Live pages of every tier, least recently used first */
+	TArray<FTierPage> GetPagesByAge() const;
+
+	/** Remove all tiers of an entry */
+	void EvictEntry(const FString& FilePath);
+
+	/** Remove one tier of an entry, clearing its owners' brush pointers and freeing its atlas slot; drops the entry once no tier is left */
+	void EvictTier(const FString& FilePath, int32 Tier);
+
+	/** Evict every thumbnail on an atlas page, optionally releasing the page itself */
+	void EvictPage(const FTierPage& Page, bool bReleasePage);
+
+	/** Find room in a tier's atlas, growing it or recycling the least recently used page */
+	bool AllocateAtlasSlot(int32 Tier, const FString& FilePath, FFastAssetsAtlasSlot& OutSlot);
+
+	/** Engine memory trim callback, may arrive on any thread */
+	void OnMemoryTrim();
+
+	/** Schedule a decode for the file, or renew the request if it is already scheduled. Returns false if the file previously failed. */
+	bool QueueDecode(const FString& FilePath, const TSharedPtr<FExternalAssetItem>& Waiter, int32 Tier, EFastAssetsThumbnailPriority Priority);
+
+	/** Hand a scheduled file to a worker: disk cache lookup, then a full decode on a miss */
+	void StartDecode(const FString& FilePath, const FFastAssetsCancelFlag& CancelFlag);
+
+	/** Produce thumbnail pixels for any supported file, picking the decoder by extension (runs on a worker thread) */
+	static bool DecodeThumbnail(IImageWrapperModule& WrapperModule, FFastAssetsThumbnailDiskCache* DiskCache, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded);
+
+	/** Load a mesh and render it with the software rasterizer (runs on a worker thread) */
+	static bool DecodeMesh(const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded);
+
+	/** Draw a sound's waveform, reusing its cached peaks when the file was summarized before (runs on a worker thread) */
+	static bool DecodeAudio(FFastAssetsThumbnailDiskCache* DiskCache, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded);
+
+	/** Scale the decoded pixels to every tier, so the game thread only copies them (runs on a worker thread) */
+	static void BuildTiers(FFastAssetsDecodedThumbnail& Decoded);
+
+	/** Read, decode and downscale an image file to fit MaxSize (runs on a worker thread) */
+	static bool DecodeImage(IImageWrapperModule& WrapperModule, const FString& FilePath, int32 MaxSize, const FFastAssetsCancelFlag& CancelFlag, FFastAssetsDecodedThumbnail& OutDecoded);
+
+	/** Upload the requested tiers into their atlases and hand the brushes to waiting items (game thread) */
+	void FinishThumbnail(FFastAssetsDecodedThumbnail& Decoded);
+
+	/** Upload the next decoded thumbnail; drained by the update applier within its frame budget */
+	bool ApplyNextUpload();
+
+	/** Upload the changed region of the next due atlas page; drained by the update applier like uploads */
+	bool PublishNextAtlasPage();
+
+	/** Trim the cache and start the most wanted decodes */
+	bool Tick(float DeltaTime);
 
 	/** Initialize asset type icons */
 	void InitializeAssetTypeIcons();
 
 private:
-	/** Cached thumbnail brushes (FilePath -> Brush) */
-	TMap<FString, TSharedPtr<FSlateBrush>> ThumbnailCache;
+	/** Cached thumbnails (FilePath -> Entry) */
+	TMap<FString, FCacheEntry> ThumbnailCache;
+
+	/** Texture pages holding every cached thumbnail, one atlas per tier with slots of the tier's size */
+	TUniquePtr<FFastAssetsThumbnailAtlas> Atlases[FastAssetsThumbnailTier::Num];
+
+	/** Evicted brushes kept alive until the next tick, so nothing drawn this frame dangles */
+	TArray<TSharedPtr<FSlateBrush>> RetiredBrushes;
+
+	/** Set by the memory trim delegate, handled on the next game thread tick */
+	std::atomic<bool> bTrimRequested;
+
+	/** Handle for the memory trim delegate */
+	FDelegateHandle MemoryTrimHandle;
+
+	/** Orders decodes by visibility and cancels the ones nobody wants any more */
+	TUniquePtr<FFastAssetsThumbnailScheduler> Scheduler;
+
+	/** A scheduled or running decode */
+	struct FPendingDecode
+	{
+		/** Items waiting for the brushes */
+		TArray<TWeakPtr<FExternalAssetItem>> Waiters;
+
+		/** Largest tier anyone asked for; every tier up to it is uploaded */
+		int32 TopTier = 0;
+	};
+
+	/** Scheduled or running decodes by file path */
+	TMap<FString, FPendingDecode> PendingDecodes;
+
+	typedef TFastAssetsShardedMap<FFastAssetsThumbnailStatus> FStatusMap;
+
+	/** Resident tiers and failed decodes by file path, shared with workers so they can skip work that is already done */
+	TSharedRef<FStatusMap, ESPMode::ThreadSafe> StatusMap;
+
+	/** Results handed from worker threads to the game thread */
+	TSharedRef<FDecodedThumbnailQueue, ESPMode::ThreadSafe> DecodedQueue;
+
+	/** Helper processes that decode images and meshes, shared with workers (null if disabled) */
+	TSharedPtr<FFastAssetsWorkerProcessPool, ESPMode::ThreadSafe> WorkerPool;
+
+	/** Persistent cache of scaled thumbnails, shared with workers (null if disabled) */
+	TSharedPtr<FFastAssetsThumbnailDiskCache, ESPMode::ThreadSafe> DiskCache;
+
+	/** Image wrapper module, loaded on the game thread and shared with workers */
+	IImageWrapperModule* ImageWrapperModule;
+
+	/** Handle for the ticker */
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/** Handle for the upload source registered with the update applier */
+	FDelegateHandle UploadSourceHandle;
 
-	/** Cached textures (need to hold references) */
-	TMap<FString, UTexture2D*> TextureCache;
+	/** Handle for the atlas page publishing source registered with the update applier */
+	FDelegateHandle PublishSourceHandle;
 
 	/** Asset type icon brushes */
 	TMap<FString, TSharedPtr<FSlateBrush>> AssetTypeIcons;
@@ -57,8 +284,8 @@ private:
 	/** Default brush for unknown types */
 	TSharedPtr<FSlateBrush> DefaultBrush;
 
-	/** Thumbnail size */
-	static const int32 ThumbnailSize = 128;
+	/** Decodes always produce the largest tier, so the disk cache can serve every tier */
+	static constexpr int32 DecodeSize = FastAssetsThumbnailTier::GetSize(FastAssetsThumbnailTier::Num - 1);
 
 	/** Singleton instance */
 	static TUniquePtr<FFastAssetsThumbnail> Instance;
@@ -0,0 +1,142 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Styling/SlateBrush.h"
+
+class FSlateTexture2DRHIRef;
+
+/**
+ * Location of one thumbnail inside the atlas
+ */
+struct FFastAssetsAtlasSlot
+{
+	int32 Page = INDEX_NONE;
+	int32 Slot = INDEX_NONE;
+
+	bool IsValid() const { return Page != INDEX_NONE && Slot != INDEX_NONE; }
+};
+
+/**
+ * Packs thumbnails into a few large textures, so a screen of tiles draws from a handful of textures.
+ *
+ * Pages are plain pixel buffers backed by one Slate dynamic image resource each, so no UObjects are
+ * created and garbage collection never sees them; a released page frees its texture right away.
+ * The texture is created once per page; after that only the rectangle that changed is copied out
+ * and uploaded on the render thread. Every page is a grid of equal slots, each with a one pixel
+ * gutter of repeated edge pixels so bilinear filtering never samples a neighbour. Game thread only.
+ */
+class FASTASSETS_API FFastAssetsThumbnailAtlas
+{
+public:
+	explicit FFastAssetsThumbnailAtlas(int32 InSlotSize);
+	~FFastAssetsThumbnailAtlas();
+
+	/** Largest thumbnail a slot can hold */
+	int32 GetSlotSize() const { return SlotSize; }
+
+	/** Number of live pages */
+	int32 GetNumPages() const { return NumLivePages; }
+
+	/** Memory held by a single page: its texture plus the pixels its updates are copied from */
+	int64 GetPageSizeBytes() const { return (int64)PageSize * PageSize * 4 * 2; }
+
+	/** Memory held by all live pages */
+	int64 GetResidentBytes() const { return NumLivePages * GetPageSizeBytes(); }
+
+	/** Claim a free slot in an existing page for Key. Returns false if every page is full. */
+	bool AllocateSlot(const FString& Key, FFastAssetsAtlasSlot& OutSlot);
+
+	/** Create a new empty page. Returns its index, or INDEX_NONE if the renderer could not create its texture. */
+	int32 AddPage();
+
+	/** Release a page and its texture; its slots must already be free */
+	void ReleasePage(int32 PageIndex);
+
+	/** Return a slot to its page */
+	void FreeSlot(const FFastAssetsAtlasSlot& Slot);
+
+	/** Copy BGRA8 pixels into a slot (Width and Height must fit in the slot). Shown once the page is next published. */
+	void Upload(const FFastAssetsAtlasSlot& Slot, const uint8* Pixels, int32 Width, int32 Height);
+
+	/** Point a brush at the Width x Height region of a slot */
+	void ApplyToBrush(const FFastAssetsAtlasSlot& Slot, int32 Width, int32 Height, FSlateBrush& Brush) const;
+
+	/** Mark a page as used now, for page-level LRU */
+	void TouchPage(int32 PageIndex);
+
+	/** Cycle count when the page was last touched; comparable between atlases */
+	uint64 GetPageLastUsed(int32 PageIndex) const { return Pages[PageIndex].LastUsed; }
+
+	/** Keys stored in a page (empty strings for free slots) */
+	const TArray<FString>& GetSlotKeys(int32 PageIndex) const;
+
+	/** Live page indices, least recently used first */
+	TArray<int32> GetPagesByAge() const;
+
+	/**
+	 * Upload the changed region of one page whose pixels changed, at most once per PublishIntervalSeconds
+	 * each. Returns false if no page is due. Meant as an update applier source.
+	 */
+	bool PublishNextPage();
+
+private:
+	struct FPage
+	{
+		/** BGRA8 pixels of the whole page, empty once the page is released */
+		TArray<uint8> Pixels;
+
+		/** Names the page's dynamic image resource; every thumbnail brush on the page uses the same name */
+		FSlateBrush Brush;
+
+		/** The page's texture, owned by the renderer and valid while the page is live */
+		FSlateTexture2DRHIRef* Texture = nullptr;
+
+		/** Region whose pixels changed since the page was last published; empty if none */
+		FIntRect DirtyRect;
+
+		/** FPlatformTime::Seconds() of the last publish */
+		double LastPublished = 0.0;
+
+		/** Key stored in each slot, empty if free */
+		TArray<FString> SlotKeys;
+		int32 NumFree = 0;
+
+		/** FPlatformTime::Cycles64() when the page was last touched */
+		uint64 LastUsed = 0;
+	};
+
+	FIntPoint GetSlotOrigin(int32 Slot) const;
+
+	bool IsLive(int32 PageIndex) const { return Pages.IsValidIndex(PageIndex) && Pages[PageIndex].Pixels.Num() > 0; }
+
+	/** Create the page's texture from its pixels */
+	bool CreatePageTexture(FPage& Page);
+
+	/** Copy the dirty region of the page's pixels out and upload it to the page's texture on the render thread */
+	void PublishPage(FPage& Page);
+
+	/** Drop the page's texture from the renderer */
+	void UnpublishPage(FPage& Page);
+
+private:
+	/** Pages by index; released pages leave an empty buffer so slots of other pages stay valid */
+	TArray<FPage> Pages;
+	int32 NumLivePages;
+
+	/** Makes resource names unique between atlases */
+	int32 AtlasId;
+
+	int32 SlotSize;
+	int32 SlotsPerRow;
+
+	/** Width and height of every page texture */
+	static constexpr int32 PageSize = 2048;
+
+	/** Repeated edge pixels around each slot */
+	static constexpr int32 Gutter = 1;
+
+	/** Uploads landing on a page in quick succession are batched into one publish of their bounding rectangle */
+	static constexpr double PublishIntervalSeconds = 0.1;
+};
@@ -0,0 +1,140 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Persistent thumbnail cache under Saved/FastAssets/ThumbnailCache.
+ *
+ * Pre-scaled BGRA8 thumbnails are LZ4 compressed and appended to a handful of large
+ * pack files. A small index file maps each key to its pack and offset. Sealed packs are
+ * memory mapped, so a warm lookup is a map find, a memcpy and a decompress without touching
+ * the source file. When the packs outgrow the budget the oldest one is dropped whole.
+ * One editor process writes the cache at a time; another instance on the same project opens it
+ * read-only. All public functions are thread safe.
+ */
+class FASTASSETS_API FFastAssetsThumbnailDiskCache
+{
+public:
+	FFastAssetsThumbnailDiskCache(const FString& InCacheDirectory, int64 InMaxCacheBytes);
+	~FFastAssetsThumbnailDiskCache();
+
+	/** Default cache location */
+	static FString GetDefaultCacheDirectory();
+
+	/** Build the cache key for a source file; any change to the file or the thumbnail size gives a new key */
+	static uint64 MakeKey(const FString& FilePath, int64 FileSize, const FDateTime& ModifiedTime, int32 ThumbnailSize);
+
+	/** Check if a thumbnail is stored for the key */
+	bool Contains(uint64 Key) const;
+
+	/** Read and decompress a stored thumbnail */
+	bool Load(uint64 Key, int32& OutWidth, int32& OutHeight, TArray<uint8>& OutPixels) const;
+
+	/** Compress and append a thumbnail */
+	void Store(uint64 Key, int32 Width, int32 Height, const TArray<uint8>& Pixels);
+
+	/** Flush pending writes to disk */
+	void Flush();
+
+private:
+	/** Where a thumbnail lives inside the packs */
+	struct FIndexEntry
+	{
+		uint64 Key = 0;
+		uint32 Offset = 0;
+		uint32 CompressedSize = 0;
+		uint16 Pack = 0;
+		uint16 Width = 0;
+		uint16 Height = 0;
+		uint16 Reserved = 0;
+	};
+
+	/** Header written in front of every record in a pack, used to validate reads */
+	struct FRecordHeader
+	{
+		uint64 Key = 0;
+		uint32 CompressedSize = 0;
+		uint16 Width = 0;
+		uint16 Height = 0;
+	};
+
+	/** A sealed, read-only pack */
+	struct FMappedPack
+	{
+		TUniquePtr<IMappedFileHandle> Handle;
+		TUniquePtr<IMappedFileRegion> Region;
+		const uint8* Data = nullptr;
+		int64 Size = 0;
+	};
+
+	FString GetPackPath(int32 PackIndex) const;
+	FString GetIndexPath() const;
+	FString GetLockPath() const;
+
+	/** Load the index, drop packs over budget and map the rest */
+	void Open();
+
+	/** Delete everything and start with an empty cache */
+	void Reset();
+
+	/** Rewrite the index file from the in-memory entries */
+	void WriteIndex();
+
+	/** Open the pack this session appends to, and the index appender (writer lock held) */
+	bool OpenWritePack();
+
+	/** Memory map a sealed pack so its records can be read */
+	void MapPack(uint16 PackIndex);
+
+	/** Delete the oldest pack and forget its entries (writer lock held) */
+	void EvictOldestPack();
+
+	/** Copy a record's compressed bytes out of its pack */
+	bool ReadRecord(const FIndexEntry& Entry, TArray<uint8>& OutRecord) const;
+
+private:
+	FString CacheDirectory;
+	int64 MaxCacheBytes;
+
+	/** Held open for writing while this process owns the cache; the platform file refuses a second writer */
+	TUniquePtr<IFileHandle> LockFile;
+
+	/** Another process owns the cache: nothing is stored, evicted or rewritten */
+	bool bReadOnly;
+
+	/** Key -> location, guarded by IndexLock */
+	TMap<uint64, FIndexEntry> Index;
+	mutable FRWLock IndexLock;
+
+	/** Sealed packs (pack index -> mapping), guarded by PacksLock */
+	TMap<uint16, FMappedPack> MappedPacks;
+	mutable FRWLock PacksLock;
+
+	/** Append state, guarded by WriterLock; taken before IndexLock and PacksLock */
+	mutable FCriticalSection WriterLock;
+	TUniquePtr<IFileHandle> WritePack;
+	TUniquePtr<IFileHandle> IndexWriter;
+	uint16 WritePackIndex;
+	int64 WritePackSize;
+
+	/** Packs on disk oldest first, their sizes and the total, guarded by WriterLock */
+	TArray<uint16> PackIndices;
+	TMap<uint16, int64> PackSizes;
+	int64 TotalBytes;
+
+	/** A pack is sealed and a new one started beyond this size */
+	int64 PackLimitBytes;
+
+	static constexpr int64 MinPackBytes = 16 * 1024 * 1024;
+	static constexpr int64 MaxPackBytes = 256 * 1024 * 1024;
+
+	static constexpr uint32 IndexMagic = 0x46415443; // 'FATC'
+	static constexpr uint32 IndexVersion = 1;
+};
@@ -0,0 +1,103 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** How urgently a thumbnail is needed */
+enum class EFastAssetsThumbnailPriority : uint8
+{
+	/** Drawn this frame */
+	Visible,
+
+	/** Expected on screen soon (next page in the scroll direction) */
+	Prefetch,
+
+	/** Nobody is waiting on it */
+	Background
+};
+
+/** Set by the scheduler when a started job is no longer wanted; workers check it between steps */
+typedef TSharedRef<std::atomic<bool>, ESPMode::ThreadSafe> FFastAssetsCancelFlag;
+
+/**
+ * Decides which thumbnails get decoded and in what order.
+ *
+ * Visible and prefetch requests must be renewed every frame by whoever wants them. A request
+ * that is not renewed goes stale and is dropped before it reaches a worker, or cancelled if it
+ * already started, so a fast scroll never leaves the pool busy with tiles that are gone.
+ * At most MaxInFlight jobs run at once. Background work runs one job at a time and never takes
+ * the last free worker, so a window opened during warm-up gets its thumbnails first. Game thread only.
+ */
+class FASTASSETS_API FFastAssetsThumbnailScheduler
+{
+public:
+	explicit FFastAssetsThumbnailScheduler(int32 InMaxInFlight);
+
+	/** Add a request or renew an existing one, raising its priority if needed */
+	void Request(const FString& FilePath, EFastAssetsThumbnailPriority Priority);
+
+	/** True if the file is queued or being decoded */
+	bool IsRequested(const FString& FilePath) const;
+
+	/**
+	 * Cancel stale work and start as many queued jobs as the in-flight limit allows,
+	 * highest priority first. OnCancelled is called for requests dropped from the queue.
+	 */
+	void Update(TFunctionRef<void(const FString&, const FFastAssetsCancelFlag&)> StartJob, TFunctionRef<void(const FString&)> OnCancelled);
+
+	/** A started job returned its result (or gave up after being cancelled) */
+	void OnJobFinished(const FString& FilePath);
+
+	/** Drop everything that has not started and cancel everything that has */
+	void CancelAll();
+
+	int32 GetNumQueued() const { return Queued.Num(); }
+	int32 GetNumInFlight() const { return InFlight.Num(); }
+
+private:
+	struct FQueuedRequest
+	{
+		EFastAssetsThumbnailPriority Priority = EFastAssetsThumbnailPriority::Background;
+		uint64 LastRequestedFrame = 0;
+	};
+
+	struct FInFlightJob
+	{
+		FFastAssetsCancelFlag CancelFlag;
+		EFastAssetsThumbnailPriority Priority;
+		uint64 LastRequestedFrame;
+
+		FInFlightJob(const FFastAssetsCancelFlag& InCancelFlag, const FQueuedRequest& Request)
+			: CancelFlag(InCancelFlag)
+			, Priority(Request.Priority)
+			, LastRequestedFrame(Request.LastRequestedFrame)
+		{
+		}
+	};
+
+	/** Background requests never go stale, the others must be renewed every couple of frames */
+	static bool IsStale(EFastAssetsThumbnailPriority Priority, uint64 LastRequestedFrame);
+
+private:
+	/** Requests waiting for a worker (FilePath -> state) */
+	TMap<FString, FQueuedRequest> Queued;
+
+	/**
+	 * Per-priority order of queued paths, newest last. Entries are not removed when a request
+	 * changes priority or is dropped; they are skipped when popped if they no longer match.
+	 */
+	TArray<FString> Order[3];
+
+	/** Jobs handed to workers */
+	TMap<FString, FInFlightJob> InFlight;
+
+	int32 MaxInFlight;
+
+	/** Frames a visible or prefetch request survives without being renewed */
+	static constexpr uint64 StaleFrames = 2;
+
+	/** Background jobs running at once */
+	static constexpr int32 MaxBackgroundInFlight = 1;
+};
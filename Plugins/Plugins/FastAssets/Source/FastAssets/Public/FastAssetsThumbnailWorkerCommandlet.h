@@ -0,0 +1,22 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FastAssetsThumbnailWorkerCommandlet.generated.h"
+
+/**
+ * Body of a thumbnail helper process (see FFastAssetsWorkerProcessPool).
+ * Decodes the files named on stdin into the shared memory region given by -SharedMemory=.
+ */
+UCLASS()
+class UFastAssetsThumbnailWorkerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UFastAssetsThumbnailWorkerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,67 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+
+/**
+ * Applies background results to Slate and UObjects on the game thread within a per-frame time budget.
+ *
+ * Updates queued from any thread and registered sources (such as the thumbnail upload queue) are
+ * drained in turn until the budget from the settings is used up; whatever is left waits for the next
+ * frame. Refreshes are keyed and coalesced: however many updates ask for one, it runs once, after
+ * the frame's updates.
+ */
+class FASTASSETS_API FFastAssetsUpdateApplier
+{
+public:
+	/** Applies one queued update and returns true, or returns false if its queue is empty */
+	DECLARE_DELEGATE_RetVal(bool, FApplyNext);
+
+	FFastAssetsUpdateApplier();
+	~FFastAssetsUpdateApplier();
+
+	/** Get the singleton; the first call must come from the game thread */
+	static FFastAssetsUpdateApplier& Get();
+
+	/** Get the singleton as a reference that keeps its queue alive, for capture by background work. Game thread only. */
+	static TSharedRef<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> GetShared();
+
+	/** Stop applying updates and release the singleton; workers still holding it can enqueue, but nothing runs */
+	static void Shutdown();
+
+	/** Run Update on the game thread once there is budget for it. Thread safe. */
+	void EnqueueUpdate(TUniqueFunction<void()>&& Update);
+
+	/** Drain another queue alongside the queued updates, one update per turn. Game thread only. */
+	FDelegateHandle AddSource(FApplyNext&& Source);
+	void RemoveSource(FDelegateHandle Handle);
+
+	/** Run Refresh after this frame's updates, replacing any refresh already requested for Key. Game thread only. */
+	void RequestRefresh(const void* Key, TUniqueFunction<void()>&& Refresh);
+
+	/** Drop a pending refresh, for owners that are going away */
+	void CancelRefresh(const void* Key);
+
+private:
+	bool Tick(float DeltaTime);
+
+	/** Apply one queued update; false if there was none */
+	bool ApplyNextUpdate();
+
+private:
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Updates;
+
+	TArray<FApplyNext> Sources;
+
+	/** Source that goes first next frame, so a busy source cannot starve the ones after it */
+	int32 FirstSource = 0;
+
+	TMap<const void*, TUniqueFunction<void()>> PendingRefreshes;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	static TSharedPtr<FFastAssetsUpdateApplier, ESPMode::ThreadSafe> Instance;
+};
@@ -0,0 +1,59 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+class FFastAssetsSharedCatalog;
+
+/**
+ * Scans the most recent folders in the background after editor startup.
+ *
+ * Nothing runs until the engine has finished initializing and a short delay has passed. Folders are
+ * then scanned one at a time, and the first thumbnails of each are queued at background priority,
+ * behind anything a window asks for. The catalogs are kept, so the first window opened on one of
+ * these folders shows it without scanning. Game thread only.
+ */
+class FASTASSETS_API FFastAssetsWarmUp
+{
+public:
+	~FFastAssetsWarmUp();
+
+	/** Warm up the top recent paths from the settings once the editor has started */
+	void Start();
+
+private:
+	void OnEngineInitComplete();
+	bool OnStartDelayElapsed(float DeltaTime);
+
+	/** Scan the next pending path that still exists */
+	void WarmUpNextPath();
+
+	void OnCatalogChanged(int32 FirstAddedIndex);
+
+	/** The current path is scanned; queue its first thumbnails and go on to the next path */
+	void FinishCurrentPath();
+
+	void QueueThumbnails(const FFastAssetsSharedCatalog& Catalog);
+
+private:
+	TArray<FString> PendingPaths;
+
+	// Warmed up catalogs, held for the session so the first window finds them scanned
+	TArray<TSharedRef<FFastAssetsSharedCatalog>> WarmCatalogs;
+
+	TSharedPtr<FFastAssetsSharedCatalog> CurrentCatalog;
+	FDelegateHandle CatalogChangedHandle;
+	double CurrentStartTime = 0.0;
+
+	FDelegateHandle EngineInitHandle;
+	FTSTicker::FDelegateHandle DelayHandle;
+
+	// Seconds after the engine finished initializing before the first scan, and between scans
+	static constexpr float StartDelaySeconds = 10.0f;
+	static constexpr float PathDelaySeconds = 2.0f;
+
+	// Thumbnails queued per folder, about the first screens of a grid
+	static constexpr int32 ThumbnailsPerPath = 256;
+};
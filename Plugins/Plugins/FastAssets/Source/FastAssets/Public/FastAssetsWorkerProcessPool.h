@@ -0,0 +1,116 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMemory.h"
+#include <atomic>
+
+/**
+ * Optional helper processes that decode thumbnails outside the editor.
+ *
+ * Each helper is this editor running the FastAssetsThumbnailWorker commandlet. It reads one file
+ * path per line on stdin, decodes and downscales the file, writes the BGRA8 pixels into a named
+ * shared memory region owned by the editor and answers with one line on stdout. A malformed file
+ * can only take down a helper: the editor sees it exit, reports the file as failed and starts a
+ * replacement on the next request. All public functions are thread safe.
+ */
+class FASTASSETS_API FFastAssetsWorkerProcessPool
+{
+public:
+	enum class EResult : uint8
+	{
+		/** Pixels were returned */
+		Decoded,
+
+		/** The helper could not decode the file, or died or hung while trying */
+		Failed,
+
+		/** No helper could be started; decode in process instead */
+		Unavailable
+	};
+
+	/** Launch NumWorkers helpers for thumbnails up to MaxSize pixels; they boot while the editor carries on */
+	FFastAssetsWorkerProcessPool(int32 NumWorkers, int32 InMaxSize);
+	~FFastAssetsWorkerProcessPool();
+
+	/** Decode a file in a helper. Blocks the calling worker thread until a helper is free and has answered. */
+	EResult Decode(const FString& FilePath, const std::atomic<bool>& CancelFlag, TArray<uint8>& OutPixels, int32& OutWidth, int32& OutHeight);
+
+	/** Name passed to -run= */
+	static constexpr const TCHAR* CommandletName = TEXT("FastAssetsThumbnailWorker");
+
+	/** First line a helper prints once it is ready for requests */
+	static constexpr const TCHAR* ReadyMarker = TEXT("FASTASSETS_WORKER_READY");
+
+	/** Prefix of the line a helper prints for every request: "<marker> OK <width> <height>" or "<marker> FAIL" */
+	static constexpr const TCHAR* ResultMarker = TEXT("FASTASSETS_WORKER_RESULT");
+
+	/** Bytes in each helper's shared memory region */
+	static int64 GetSharedMemorySize(int32 MaxSize) { return (int64)MaxSize * MaxSize * 4; }
+
+private:
+	struct FWorker
+	{
+		FProcHandle Process;
+
+		/** Our ends of the helper's stdin and stdout, plus the ends handed to the helper */
+		void* StdinRead = nullptr;
+		void* StdinWrite = nullptr;
+		void* StdoutRead = nullptr;
+		void* StdoutWrite = nullptr;
+
+		FPlatformMemory::FSharedMemoryRegion* SharedMemory = nullptr;
+
+		/** Stdout received but not yet split into lines */
+		FString Output;
+
+		/** The helper printed ReadyMarker */
+		bool bReady = false;
+
+		/** Launches in a row that never became ready; the slot is given up after MaxLaunchAttempts */
+		int32 FailedLaunches = 0;
+
+		/** Makes shared memory names unique across relaunches */
+		int32 Generation = 0;
+	};
+
+	/** Create the shared memory and pipes and start the helper process */
+	bool LaunchWorker(int32 WorkerIndex);
+
+	/** Wait for a launched helper to report it is ready */
+	bool WaitUntilReady(FWorker& Worker);
+
+	/** Kill the helper if it is still running and free its pipes and shared memory */
+	void StopWorker(FWorker& Worker);
+
+	/** Read stdout until a line starting with Marker arrives. Fails if the helper exits or the timeout passes. */
+	bool ReadMarkedLine(FWorker& Worker, const TCHAR* Marker, double TimeoutSeconds, FString& OutLine);
+
+	/** Take an idle helper, waiting for one to come free. Returns INDEX_NONE if cancelled or none can run. */
+	int32 AcquireWorker(const std::atomic<bool>& CancelFlag);
+	void ReleaseWorker(int32 WorkerIndex);
+
+	bool IsUsable(const FWorker& Worker) const { return Worker.FailedLaunches < MaxLaunchAttempts; }
+
+private:
+	TArray<TUniquePtr<FWorker>> Workers;
+
+	/** Guards IdleWorkers; a helper belongs to exactly one thread between acquire and release */
+	FCriticalSection IdleLock;
+	TArray<int32> IdleWorkers;
+
+	/** Triggered whenever a helper is released */
+	FEvent* WorkerReleased;
+
+	int32 MaxSize;
+
+	static constexpr int32 MaxLaunchAttempts = 3;
+
+	/** A helper boots a whole editor, which can take a while on a cold machine */
+	static constexpr double StartupTimeoutSeconds = 120.0;
+
+	/** A helper that takes longer than this on one file is assumed to be stuck on it */
+	static constexpr double DecodeTimeoutSeconds = 30.0;
+};
@@ -4,12 +4,23 @@
 
 #include "CoreMinimal.h"
 #include "Widgets/Views/STableRow.h"
+#include "Types/SlateStructs.h"
 #include "SFastAssetsWindow.h"
 
 DECLARE_DELEGATE_RetVal_OneParam(FReply, FOnAssetDragDetected, TSharedPtr<FExternalAssetItem>);
 
+namespace FastAssetsColors
+{
+	/** Placeholder color for an asset type */
+	FLinearColor GetColorForAssetType(const FString& AssetType);
+}
+
+/** Called while painting a row, with the row's index in the list */
+DECLARE_DELEGATE_OneParam(FOnAssetRowPainted, int32);
+
 /**
- * Custom table row widget with drag support for list view
+ * Custom table row widget with drag support for list view.
+ * The widgets are built once and read the item through attributes, so a row can be recycled for another item.
  */
 class SAssetListRow : public SMultiColumnTableRow<TSharedPtr<FExternalAssetItem>>
 {
@@ -17,25 +28,50 @@ public:
 	SLATE_BEGIN_ARGS(SAssetListRow) {}
 		SLATE_ARGUMENT(TSharedPtr<FExternalAssetItem>, AssetItem)
 		SLATE_EVENT(FOnAssetDragDetected, OnDragDetected)
+		SLATE_EVENT(FOnAssetRowPainted, OnPainted)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable);
 
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
 
+	/** Show another item in this row */
+	void SetAssetItem(const TSharedPtr<FExternalAssetItem>& InAssetItem);
+
 	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual FReply OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	/** Edge length of the icon in the name column */
+	static constexpr int32 IconSize = 24;
+
+	/** Thumbnail tier the icon is drawn from */
+	static int32 GetThumbnailTier() { return FastAssetsThumbnailTier::ForSize(IconSize); }
 
 private:
-	FString FormatFileSize(int64 SizeInBytes) const;
+	/** Thumbnail brush of the item, null until its background decode finishes */
+	const FSlateBrush* GetThumbnailImage() const;
+	EVisibility GetPlaceholderVisibility() const;
+
+	FSlateColor GetTypeColor() const { return TypeColor; }
+	FText GetTypeLetterText() const;
+	FText GetNameText() const;
+	FText GetTypeText() const;
+	FText GetSizeText() const;
+	FText GetExtensionText() const;
 
 private:
 	TSharedPtr<FExternalAssetItem> AssetItem;
 	FOnAssetDragDetected OnDragDetectedDelegate;
+	FOnAssetRowPainted OnPaintedDelegate;
+
+	/** Placeholder color for the item's asset type */
+	FLinearColor TypeColor;
 };
 
 /**
- * Custom tile widget with drag support for grid view
+ * Custom tile widget with drag support for grid view.
+ * Like the list row it can be recycled for another item.
  */
 class SAssetTile : public STableRow<TSharedPtr<FExternalAssetItem>>
 {
@@ -43,14 +79,49 @@ public:
 	SLATE_BEGIN_ARGS(SAssetTile) {}
 		SLATE_ARGUMENT(TSharedPtr<FExternalAssetItem>, AssetItem)
 		SLATE_EVENT(FOnAssetDragDetected, OnDragDetected)
+		SLATE_EVENT(FOnAssetRowPainted, OnPainted)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTable);
 
 	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
 	virtual FReply OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+	/** Show another item in this tile */
+	void SetAssetItem(const TSharedPtr<FExternalAssetItem>& InAssetItem);
+
+	/** Thumbnail tier the tile is drawn from, following the thumbnail size setting */
+	static int32 GetThumbnailTier() { return FFastAssetsThumbnail::GetGridTier(); }
+
+	/** Edge length of the thumbnail box, following the thumbnail size setting */
+	static int32 GetThumbnailBoxSize();
+
+	/** Space a tile takes in the tile view, including its padding */
+	static FVector2D GetItemSize();
+
+private:
+	/** Thumbnail brush of the item, null until its background decode finishes */
+	const FSlateBrush* GetThumbnailImage() const;
+	EVisibility GetPlaceholderVisibility() const;
+
+	FSlateColor GetTypeColor() const { return TypeColor; }
+	FText GetTypeLetterText() const;
+	FText GetNameText() const;
+
+	FOptionalSize GetTileWidth() const { return GetThumbnailBoxSize() + TileMargin; }
+	FOptionalSize GetTileHeight() const { return GetThumbnailBoxSize() + TileMargin + NameHeight; }
+	FOptionalSize GetThumbnailBoxSizeOverride() const { return GetThumbnailBoxSize(); }
 
 private:
 	TSharedPtr<FExternalAssetItem> AssetItem;
 	FOnAssetDragDetected OnDragDetectedDelegate;
+	FOnAssetRowPainted OnPaintedDelegate;
+
+	/** Placeholder color for the item's asset type */
+	FLinearColor TypeColor;
+
+	/** Space around the thumbnail box, and below it for the file name */
+	static constexpr int32 TileMargin = 10;
+	static constexpr int32 NameHeight = 20;
 };
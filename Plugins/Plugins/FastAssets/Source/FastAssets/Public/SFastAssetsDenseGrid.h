@@ -0,0 +1,165 @@
+// Copyright Ismail Faruk Kocademir. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Framework/SlateDelegates.h"
+#include "Fonts/ShapedTextFwd.h"
+#include "SAssetTableRow.h"
+
+class SScrollBar;
+
+/** Items for the dense grid that are built on demand rather than kept in an array */
+class IFastAssetsItemSource
+{
+public:
+	virtual ~IFastAssetsItemSource() = default;
+
+	virtual int32 Num() const = 0;
+
+	/** Item at Index; an item still referenced elsewhere must be returned again, not rebuilt */
+	virtual TSharedPtr<FExternalAssetItem> GetItem(int32 Index) const = 0;
+
+	/** Index of Item, or INDEX_NONE if it is no longer in the source */
+	virtual int32 FindItem(const FExternalAssetItem& Item) const = 0;
+};
+
+/**
+ * Grid of small tiles drawn by a single leaf widget.
+ *
+ * Tile positions are computed from the scroll offset, so there are no per-tile widgets to prepass,
+ * arrange or paint. Backgrounds, thumbnails, type badges and labels are emitted as batched draw
+ * elements in one OnPaint, each kind on its own layer so Slate can merge them into few draw calls.
+ * Labels are shaped once per item and reused across refreshes until the DPI scale changes.
+ * Selection, drag and the context menu are hit-tested here as well.
+ */
+class SFastAssetsDenseGrid : public SLeafWidget
+{
+public:
+	typedef TSlateDelegates<TSharedPtr<FExternalAssetItem>>::FOnSelectionChanged FOnSelectionChanged;
+
+	SLATE_BEGIN_ARGS(SFastAssetsDenseGrid)
+		: _ItemsSource(nullptr)
+	{}
+		SLATE_ARGUMENT(const TArray<TSharedPtr<FExternalAssetItem>>*, ItemsSource)
+		SLATE_ARGUMENT(TSharedPtr<SScrollBar>, ExternalScrollbar)
+		SLATE_EVENT(FOnSelectionChanged, OnSelectionChanged)
+		SLATE_EVENT(FOnContextMenuOpening, OnContextMenuOpening)
+		SLATE_EVENT(FOnAssetDragDetected, OnDragDetected)
+		SLATE_EVENT(FOnAssetRowPainted, OnPainted)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** The items source changed; drops selected items that are gone */
+	void RequestRefresh();
+
+	/** Show items paged in from Source instead of the items source array, or go back to the array when null */
+	void SetPagedItems(const TSharedPtr<IFastAssetsItemSource>& Source);
+
+	/** Scroll so the item that was at OldIndex keeps its place on screen now that it is at NewIndex */
+	void ShiftScrollAnchor(int32 OldIndex, int32 NewIndex);
+
+	TArray<TSharedPtr<FExternalAssetItem>> GetSelectedItems() const;
+
+	/** Thumbnail edge length, half the thumbnail size setting so many more tiles fit */
+	static int32 GetThumbnailSize();
+
+	/** Thumbnail tier the tiles are drawn from */
+	static int32 GetThumbnailTier();
+
+	// SWidget interface
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseMove(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual void OnMouseLeave(const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnDragDetected(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnKeyDown(const FGeometry& MyGeometry, const FKeyEvent& InKeyEvent) override;
+	virtual bool SupportsKeyboardFocus() const override { return true; }
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	/** Size of one tile, including the padding around it */
+	static FVector2D GetTileSize();
+
+	int32 GetNumColumns(float ViewWidth) const;
+	int32 GetNumItems() const { return PagedItems.IsValid() ? PagedItems->Num() : ItemsSource ? ItemsSource->Num() : 0; }
+	TSharedPtr<FExternalAssetItem> GetItem(int32 Index) const { return PagedItems.IsValid() ? PagedItems->GetItem(Index) : (*ItemsSource)[Index]; }
+
+	/** Index of the item under a local position, or INDEX_NONE */
+	int32 GetIndexAt(const FVector2D& LocalPosition) const;
+
+	float GetMaxScrollOffset() const;
+	void SetScrollOffset(float NewOffset);
+	void OnScrollbarScrolled(float OffsetFraction);
+
+	bool IsSelected(const TSharedPtr<FExternalAssetItem>& Item) const { return SelectedItems.Contains(Item); }
+	void SelectSingle(int32 Index);
+	void SelectRange(int32 FromIndex, int32 ToIndex);
+	void ToggleSelected(int32 Index);
+	void ClearSelection();
+	void NotifySelectionChanged(const TSharedPtr<FExternalAssetItem>& Item);
+
+	/** Whether Item is still in the items source, which is ordered by SortIndex */
+	bool IsInItemsSource(const TSharedPtr<FExternalAssetItem>& Item) const;
+
+	/** Label for an item, shaped and cut to the tile width the first time it is drawn */
+	FShapedGlyphSequenceRef GetShapedLabel(const TSharedPtr<FExternalAssetItem>& Item, float FontScale, float MaxWidth) const;
+	FShapedGlyphSequenceRef GetShapedTypeLetter(const FExternalAssetItem& Item, float FontScale) const;
+
+private:
+	const TArray<TSharedPtr<FExternalAssetItem>>* ItemsSource = nullptr;
+	TSharedPtr<IFastAssetsItemSource> PagedItems;
+	TSharedPtr<SScrollBar> ScrollBar;
+
+	FOnSelectionChanged OnSelectionChanged;
+	FOnContextMenuOpening OnContextMenuOpening;
+	FOnAssetDragDetected OnDragDetectedDelegate;
+	FOnAssetRowPainted OnPaintedDelegate;
+
+	float ScrollOffset = 0.0f;
+
+	/** Height of the area last painted, for clamping and the scroll bar */
+	float ViewHeight = 0.0f;
+	float ViewWidth = 0.0f;
+
+	TSet<TSharedPtr<FExternalAssetItem>> SelectedItems;
+
+	/** Anchor for shift-click range selection */
+	int32 SelectionAnchor = INDEX_NONE;
+
+	/** Item pressed without a modifier while already selected; selected alone on release unless dragged */
+	int32 PendingSelectIndex = INDEX_NONE;
+
+	/** Item under the mouse when the drag started */
+	int32 PressedIndex = INDEX_NONE;
+
+	int32 HoveredIndex = INDEX_NONE;
+
+	struct FCachedLabel
+	{
+		/** Checked on lookup, since a freed item's address can be reused by a new one */
+		TWeakPtr<FExternalAssetItem> Item;
+		FShapedGlyphSequenceRef Label;
+	};
+
+	/** Shaped labels by item, valid for LabelCacheScale */
+	mutable TMap<const FExternalAssetItem*, FCachedLabel> LabelCache;
+	mutable TMap<FString, FShapedGlyphSequenceRef> TypeLetterCache;
+	mutable float LabelCacheScale = 0.0f;
+
+	static constexpr float TilePadding = 3.0f;
+	static constexpr float LabelHeight = 14.0f;
+	static constexpr float BadgeHeight = 3.0f;
+	static constexpr int32 MaxCachedLabels = 8192;
+
+	/** Range selection over paged items stops here, so shift-click or select all cannot page in the whole source */
+	static constexpr int32 MaxPagedRangeSelection = 100000;
+};
@@ -7,11 +7,22 @@
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Views/STileView.h"
+#include "Widgets/Views/STreeView.h"
+#include "FastAssetsThumbnail.h"
+#include "FastAssetsFolderTree.h"
+#include <atomic>
 
 // Forward declarations
 class SEditableTextBox;
 class SWidgetSwitcher;
 class STextBlock;
+class SAssetListRow;
+class SAssetTile;
+class SFastAssetsDenseGrid;
+class FFastAssetsCatalog;
+class FFastAssetsCatalogView;
+class FFastAssetsCatalogItemSource;
+class FFastAssetsSharedCatalog;
 struct FSlateBrush;
 
 struct FExternalAssetItem
@@ -23,12 +34,24 @@ struct FExternalAssetItem
 	int64 FileSize;
 	FDateTime ModifiedTime;
 
-	/** Cached thumbnail brush for this asset */
-	const FSlateBrush* ThumbnailBrush = nullptr;
+	/** Position in the scan results; filtered lists keep this order, so items can be found by binary search */
+	int32 SortIndex = INDEX_NONE;
+
+	/** Display text built once at scan time, so rows never format text while scrolling */
+	FText NameText;
+	FText TypeText;
+	FText TypeLetterText;
+	FText SizeText;
+	FText ExtensionText;
+
+	/** Cached thumbnail brush per tier (cleared by the thumbnail cache when that tier is evicted) */
+	const FSlateBrush* ThumbnailBrushes[FastAssetsThumbnailTier::Num] = {};
+
+	/** Frame in which a widget last displayed each tier, keeps it from being evicted while on screen */
+	uint64 ThumbnailLastDrawnFrames[FastAssetsThumbnailTier::Num] = {};
 
 	FExternalAssetItem()
 		: FileSize(0)
-		, ThumbnailBrush(nullptr)
 	{
 	}
 };
@@ -43,23 +66,29 @@ class SFastAssetsWindow : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SFastAssetsWindow) {}
+		/** Folder to show right away instead of the remembered one */
+		SLATE_ARGUMENT(FString, InitialPath)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 
 	virtual ~SFastAssetsWindow();
 
+	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
+
 private:
 	// UI Construction
 	TSharedRef<SWidget> ConstructToolbar();
 	TSharedRef<SWidget> ConstructPathBar();
 	TSharedRef<SWidget> ConstructSearchBar();
+	TSharedRef<SWidget> ConstructFolderTree();
 	TSharedRef<SWidget> ConstructContentArea();
 	TSharedRef<SWidget> ConstructStatusBar();
 
 	// Toolbar Actions
 	FReply OnBrowseClicked();
 	FReply OnRefreshClicked();
+	FReply OnNewTabClicked();
 	FReply OnSettingsClicked();
 	FReply OnGridViewClicked();
 	FReply OnListViewClicked();
@@ -72,22 +101,67 @@ private:
 	void OnSearchTextChanged(const FText& NewText);
 
 	// Directory Scanning
+	/** Show Path, scanning it unless another window already has; showing the same folder again rescans it */
 	void ScanDirectory(const FString& Path);
-	void ScanDirectoryAsync(const FString& Path);
-	FString DetermineAssetType(const FString& Extension) const;
-	FString FormatFileSize(int64 SizeInBytes) const;
+
+	/** Show the assets of another catalog, dropping this window's view of the previous one */
+	void ShowCatalog(const TSharedRef<FFastAssetsSharedCatalog>& NewCatalog);
+
+	/** Assets were appended to the catalog from FirstAddedIndex on, or any of them changed if INDEX_NONE */
+	void OnCatalogChanged(int32 FirstAddedIndex);
 
 	// List View
 	TSharedRef<ITableRow> OnGenerateAssetRow(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
 
+	void OnAssetRowReleased(const TSharedRef<ITableRow>& Row);
+
 	// Grid View
 	TSharedRef<ITableRow> OnGenerateAssetTile(TSharedPtr<FExternalAssetItem> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnAssetTileReleased(const TSharedRef<ITableRow>& Row);
+
+	// Folder Tree
+	TSharedRef<ITableRow> OnGenerateFolderRow(TSharedPtr<FFastAssetsFolderNode> Folder, const TSharedRef<STableViewBase>& OwnerTable);
+	void OnGetFolderChildren(TSharedPtr<FFastAssetsFolderNode> Folder, TArray<TSharedPtr<FFastAssetsFolderNode>>& OutChildren);
+
+	/** Show only the assets below the clicked folder, filtered from the scanned assets without rescanning */
+	void OnFolderSelectionChanged(TSharedPtr<FFastAssetsFolderNode> Folder, ESelectInfo::Type SelectInfo);
+
+	// Dense Grid View
+	bool IsDenseGridEnabled() const;
+
+	/** Switcher slot to show: the tile view, the list view or the dense grid */
+	int32 GetViewWidgetIndex() const;
+
+	// Thumbnail Prefetch
+	void OnAssetRowPainted(int32 IndexInList);
+	void UpdateThumbnailPrefetch();
 
 	// Selection
 	void OnAssetSelectionChanged(TSharedPtr<FExternalAssetItem> Item, ESelectInfo::Type SelectInfo);
 
 	// Filtering
-	void RefreshFilteredAssets();
+	/** Filter the catalog's assets again, or only the current FilteredAssets if the filter can only have become stricter */
+	void RefreshFilteredAssets(bool bOnlyNarrowing = false);
+
+	/** Swap in a new filtered list, keeping the first visible item in place */
+	void ApplyFilteredAssets(TArray<TSharedPtr<FExternalAssetItem>>&& NewFilteredAssets);
+
+	/** Filter the catalog on disk on a worker, or only the current view if the filter can only have become stricter */
+	void RefreshCatalogView(const TSharedRef<FFastAssetsCatalog>& DiskCatalog, bool bOnlyNarrowing);
+	void ApplyCatalogView(const TSharedRef<FFastAssetsCatalogView>& View);
+	void SetCatalogItems(const TSharedPtr<FFastAssetsCatalogItemSource>& Items);
+
+	/** Shown assets, whether they are in FilteredAssets or a catalog on disk */
+	int32 GetNumFilteredAssets() const;
+	TSharedPtr<FExternalAssetItem> GetFilteredAsset(int32 Index) const;
+
+	/** Index of the first item at or after SortIndex in a list ordered like the catalog's assets */
+	static int32 FindBySortIndex(const TArray<TSharedPtr<FExternalAssetItem>>& Items, int32 SortIndex);
+
+	/** Refresh the views and status once, after this frame's updates */
+	void RequestViewRefresh();
+	void RefreshViews();
+	void UpdateStatusText();
 	bool PassesFilter(const TSharedPtr<FExternalAssetItem>& Item) const;
 
 	// Drag and Drop
@@ -105,8 +179,9 @@ private:
 	// Current directory path
 	FString CurrentPath;
 
-	// All scanned assets
-	TArray<TSharedPtr<FExternalAssetItem>> AllAssets;
+	// Scanned assets of the folder shown, shared with other windows showing the same folder
+	TSharedPtr<FFastAssetsSharedCatalog> Catalog;
+	FDelegateHandle CatalogChangedHandle;
 
 	// Filtered assets (after search/filter)
 	TArray<TSharedPtr<FExternalAssetItem>> FilteredAssets;
@@ -121,9 +196,39 @@ private:
 	TSharedPtr<SEditableTextBox> PathTextBox;
 	TSharedPtr<SListView<TSharedPtr<FExternalAssetItem>>> AssetListView;
 	TSharedPtr<STileView<TSharedPtr<FExternalAssetItem>>> AssetTileView;
+	TSharedPtr<SFastAssetsDenseGrid> DenseGrid;
+	TSharedPtr<STreeView<TSharedPtr<FFastAssetsFolderNode>>> FolderTreeView;
 	TSharedPtr<SWidgetSwitcher> ViewSwitcher;
 	TSharedPtr<STextBlock> StatusText;
 
 	// Selected assets
 	TArray<TSharedPtr<FExternalAssetItem>> SelectedAssets;
+
+	// Range of FilteredAssets painted since the last tick
+	int32 PaintedIndexMin = INDEX_NONE;
+	int32 PaintedIndexMax = INDEX_NONE;
+
+	// First painted index last tick and the direction it moved in, for prefetching
+	int32 LastFirstVisibleIndex = INDEX_NONE;
+	int32 ScrollDirection = 1;
+
+	// Thumbnail box size the tile view was last laid out for
+	int32 TileThumbnailBoxSize = 0;
+
+	// Root of the catalog's folder tree, and the tree version the view was last refreshed for
+	TArray<TSharedPtr<FFastAssetsFolderNode>> FolderTreeRoots;
+	uint32 FolderTreeVersion = 0;
+
+	// Only assets whose path starts with this are shown; empty shows the whole scanned folder
+	FString FolderFilterPrefix;
+
+	// Filtered view of the catalog on disk, when it is kept on disk; FilteredAssets stays empty
+	TSharedPtr<FFastAssetsCatalogItemSource> CatalogItems;
+
+	// Set to stop the running catalog filter
+	TSharedPtr<std::atomic<bool>, ESPMode::ThreadSafe> FilterCancelFlag;
+
+	// Rows and tiles the views released, rebound to the next items they generate
+	TArray<TSharedRef<SAssetListRow>> ListRowPool;
+	TArray<TSharedRef<SAssetTile>> TilePool;
 };